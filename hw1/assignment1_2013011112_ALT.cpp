@@ -0,0 +1,635 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell index
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+} OpenNode;
+
+// open list -> indexed 4-ary min heap of open nodes
+// pos keeps heap position of every cell (-1 -> not in heap) for decrease-key
+typedef struct OpenHeap {
+	OpenHeap(int);
+	bool empty() const;
+	int size() const;
+	bool contains(int) const;
+	const OpenNode &top() const;
+	const OpenNode &at(int) const;
+	void push(const OpenNode &);
+	void pop();
+	void decreaseKey(int, int);
+	void siftUp(int);
+	void siftDown(int);
+
+	vector<OpenNode> heap;
+	vector<int> pos;
+} OpenHeap;
+
+// result info -> length, time, placed landmarks, preprocess and search time
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+	int landmark_num;
+	double preprocess_ms;
+	double search_ms;
+} Result;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// landmark info -> K landmarks and their length fields
+// length is quantized to 16 bits (length / quantum) and stored cell-major -> dist[cell * num + l]
+typedef struct Landmark {
+	Landmark();
+
+	int num;
+	int quantum;
+	vector<Point> p;
+	vector<uint16_t> dist;
+} Landmark;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+// heap size is bounded by cell_num
+OpenHeap::OpenHeap(int cell_num)
+	: pos(cell_num, -1) {}
+
+bool OpenHeap::empty() const {
+	return heap.empty();
+}
+
+int OpenHeap::size() const {
+	return static_cast<int>(heap.size());
+}
+
+bool OpenHeap::contains(int cell) const {
+	return pos[cell] != -1;
+}
+
+const OpenNode &OpenHeap::top() const {
+	return heap[0];
+}
+
+const OpenNode &OpenHeap::at(int cell) const {
+	return heap[pos[cell]];
+}
+
+void OpenHeap::push(const OpenNode &node) {
+	heap.push_back(node);
+	siftUp(size() - 1);
+}
+
+void OpenHeap::pop() {
+	pos[heap[0].cell] = -1;
+
+	OpenNode last = heap.back();
+	heap.pop_back();
+	if (!heap.empty()) {
+		heap[0] = last;
+		siftDown(0);
+	}
+}
+
+// set smaller score of cell in heap
+void OpenHeap::decreaseKey(int cell, int score) {
+	int i = pos[cell];
+	heap[i].score = score;
+	siftUp(i);
+}
+
+void OpenHeap::siftUp(int i) {
+	OpenNode node = heap[i];
+
+	while (i > 0) {
+		int parent = (i - 1) / 4;
+		if (!(heap[parent] > node))
+			break;
+
+		heap[i] = heap[parent];
+		pos[heap[i].cell] = i;
+		i = parent;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+void OpenHeap::siftDown(int i) {
+	OpenNode node = heap[i];
+	int n = size();
+
+	while (true) {
+		int first_child = 4 * i + 1;
+		if (first_child >= n)
+			break;
+
+		// smallest of up to 4 children
+		int best = first_child;
+		int last_child = min(first_child + 4, n);
+		for (int c = first_child + 1; c < last_child; c++)
+			if (heap[best] > heap[c])
+				best = c;
+
+		if (!(node > heap[best]))
+			break;
+
+		heap[i] = heap[best];
+		pos[heap[i].cell] = i;
+		i = best;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+Result::Result()
+	: length(0), time(0), landmark_num(0), preprocess_ms(0.0), search_ms(0.0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_), landmark_num(0), preprocess_ms(0.0), search_ms(0.0) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+	landmark_num = res.landmark_num;
+	preprocess_ms = res.preprocess_ms;
+	search_ms = res.search_ms;
+
+	return *this;
+}
+
+Landmark::Landmark()
+	: num(0), quantum(1) {}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+// quantized length of cell not reached from landmark
+const uint16_t UNREACHED = 0xFFFF;
+
+Result calc(Map **, int, int, Point &, vector<Point> &, int);
+void buildLandmark(Map **, int, int, int, Landmark &);
+void bfsLength(const vector<uint8_t> &, int, int, int, vector<int> &);
+int landmarkLength(const Landmark &, int, int, const vector<int> &);
+
+// usage: ./ALT [K] -> A* with K landmarks (8 by default), K = 0 -> manhattan distance only
+// landmark memory -> K * 2 bytes per cell
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// number of landmarks
+	int k = 8;
+	if (argc > 1) {
+		k = atoi(argv[1]);
+		if (k < 0) {
+			cerr << "K value error" << endl;
+			return -1;
+		}
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	Point start;
+	vector<Point> goal;
+	Result result;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// calc best result
+	result = calc(map_info, row, col, start, goal, k);
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// best result
+	if (result.length != -1) {
+		output_f << "length=" << result.length << endl;
+		output_f << "time=" << result.time << endl;
+	}
+	// no result
+	else {
+		output_f << "time=" << result.time << endl;
+		output_f << "no result" << endl;
+	}
+
+	output_f << "landmarks=" << result.landmark_num << endl;
+	output_f << "preprocess_ms=" << result.preprocess_ms << endl;
+	output_f << "search_ms=" << result.search_ms << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// calc result road using A* search algorithm with ALT heuristic
+// h(n) = min over goals of max(manhattan, max over landmarks |d(L,n) - d(L,goal)|)
+Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal, int k) {
+	Result res;
+	int cell_num = row * col;
+
+	// preprocess -> landmark length fields, independent of start and goal
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	Landmark landmark;
+	buildLandmark(map, row, col, k, landmark);
+	res.landmark_num = landmark.num;
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	res.preprocess_ms = chrono::duration<double, milli>(end - begin).count();
+
+	begin = chrono::steady_clock::now();
+
+	vector<int> goal_cell(goal.size());
+	for (uint i = 0; i < goal.size(); i++)
+		goal_cell[i] = goal[i].row * col + goal[i].col;
+
+	// per-cell length from start, parent cell index and closed flag
+	vector<int> length_from_start(cell_num, 0);
+	vector<int> parent(cell_num, -1);
+	vector<uint8_t> closed(cell_num, 0);
+
+	// cell index offset of UP, RIGHT, DOWN, LEFT
+	int dir_offset[4] = {-col, 1, col, -1};
+
+	int start_idx = start.row * col + start.col;
+	parent[start_idx] = start_idx;
+	closed[start_idx] = 1;
+
+	OpenHeap search_queue(cell_num);
+	search_queue.push(OpenNode(0, 0, start_idx));
+	int goal_idx = -1;
+
+	// search continuously until finding result
+	// search_queue is empty when there is no result
+	while (!search_queue.empty()) {
+		int cur_idx = search_queue.top().cell;
+		search_queue.pop();
+
+		res.time++;
+
+		// check if goal node
+		if (map[cur_idx / col][cur_idx % col] == Map::GOAL) {
+			goal_idx = cur_idx;
+			break;
+		}
+
+		closed[cur_idx] = 1;
+
+		int cur_row = cur_idx / col;
+		int cur_col = cur_idx % col;
+		int next_length = length_from_start[cur_idx] + 1;
+
+		for (int d = 0; d < 4; d++) {
+			if ((d == 0 && cur_row == 0) || (d == 1 && cur_col == col - 1) ||
+					(d == 2 && cur_row == row - 1) || (d == 3 && cur_col == 0))
+				continue;
+
+			int next_idx = cur_idx + dir_offset[d];
+			Map next_cell = map[next_idx / col][next_idx % col];
+			if (next_cell != Map::ROAD && next_cell != Map::GOAL)
+				continue;
+
+			if (search_queue.contains(next_idx)) {
+				if (next_length < length_from_start[next_idx]) {
+					length_from_start[next_idx] = next_length;
+					parent[next_idx] = cur_idx;
+					search_queue.decreaseKey(next_idx, next_length + search_queue.at(next_idx).length_to_goal);
+				}
+			}
+			// new cell, or closed cell reached with shorter length
+			// quantized landmark bound can be inconsistent -> closed cell is opened again
+			else if (!closed[next_idx] || next_length < length_from_start[next_idx]) {
+				int length_to_goal = landmarkLength(landmark, next_idx, col, goal_cell);
+				length_from_start[next_idx] = next_length;
+				parent[next_idx] = cur_idx;
+				closed[next_idx] = 0;
+				search_queue.push(OpenNode(next_length + length_to_goal, length_to_goal, next_idx));
+			}
+		}
+	}
+
+	// make result road to start point from goal
+	if (goal_idx != -1) {
+		int track_road = parent[goal_idx];
+		while (track_road != start_idx) {
+			map[track_road / col][track_road % col] = Map::ROAD_G;
+			res.length++;
+
+			track_road = parent[track_road];
+		}
+	}
+	// no result
+	else
+		res.length = -1;
+
+	end = chrono::steady_clock::now();
+	res.search_ms = chrono::duration<double, milli>(end - begin).count();
+
+	return res;
+}
+
+// pick k landmarks by farthest-point selection and store their quantized length fields
+void buildLandmark(Map **map, int row, int col, int k, Landmark &landmark) {
+	int cell_num = row * col;
+
+	// every cell except WALL can be passed
+	vector<uint8_t> walkable(cell_num);
+	int walkable_num = 0;
+	int first_cell = -1;
+	for (int i = 0; i < cell_num; i++) {
+		walkable[i] = (map[i / col][i % col] != Map::WALL);
+		walkable_num += walkable[i];
+		if (walkable[i] && first_cell == -1)
+			first_cell = i;
+	}
+
+	if (k == 0 || first_cell == -1)
+		return;
+
+	// length < walkable_num -> quantized length always fits below UNREACHED
+	landmark.quantum = walkable_num / (UNREACHED - 1) + 1;
+	landmark.dist.assign(static_cast<size_t>(cell_num) * k, UNREACHED);
+
+	vector<int> length(cell_num);
+	vector<int> min_length(cell_num, INT_MAX);
+
+	// first landmark -> farthest cell from first walkable cell
+	bfsLength(walkable, row, col, first_cell, length);
+	int next_cell = first_cell;
+	for (int i = 0; i < cell_num; i++)
+		if (length[i] > length[next_cell])
+			next_cell = i;
+
+	for (int l = 0; l < k; l++) {
+		landmark.p.emplace_back(next_cell / col, next_cell % col);
+		landmark.num++;
+
+		bfsLength(walkable, row, col, next_cell, length);
+		for (int i = 0; i < cell_num; i++) {
+			if (length[i] < 0)
+				continue;
+
+			landmark.dist[static_cast<size_t>(i) * k + l] = static_cast<uint16_t>(length[i] / landmark.quantum);
+			min_length[i] = min(min_length[i], length[i]);
+		}
+
+		// next landmark -> farthest cell from every landmark so far
+		next_cell = -1;
+		for (int i = 0; i < cell_num; i++)
+			if (length[i] >= 0 && (next_cell == -1 || min_length[i] > min_length[next_cell]))
+				next_cell = i;
+
+		if (min_length[next_cell] == 0)
+			break;
+	}
+
+	// keep stride k of dist even when fewer landmarks are found
+	if (landmark.num < k) {
+		vector<uint16_t> packed(static_cast<size_t>(cell_num) * landmark.num);
+		for (int i = 0; i < cell_num; i++)
+			for (int l = 0; l < landmark.num; l++)
+				packed[static_cast<size_t>(i) * landmark.num + l] = landmark.dist[static_cast<size_t>(i) * k + l];
+		landmark.dist.swap(packed);
+	}
+}
+
+// breadth-first search length from src to every cell, -1 -> not reached
+void bfsLength(const vector<uint8_t> &walkable, int row, int col, int src, vector<int> &length) {
+	fill(length.begin(), length.end(), -1);
+
+	vector<int> search_queue;
+	search_queue.reserve(row * col);
+	search_queue.push_back(src);
+	length[src] = 0;
+
+	for (uint head = 0; head < search_queue.size(); head++) {
+		int cur_idx = search_queue[head];
+		int cur_row = cur_idx / col;
+		int cur_col = cur_idx % col;
+
+		int next_idx[4] = {-1, -1, -1, -1};
+		if (cur_row > 0)
+			next_idx[0] = cur_idx - col;
+		if (cur_col < col - 1)
+			next_idx[1] = cur_idx + 1;
+		if (cur_row < row - 1)
+			next_idx[2] = cur_idx + col;
+		if (cur_col > 0)
+			next_idx[3] = cur_idx - 1;
+
+		for (int d = 0; d < 4; d++) {
+			int n = next_idx[d];
+			if (n == -1 || !walkable[n] || length[n] != -1)
+				continue;
+
+			length[n] = length[cur_idx] + 1;
+			search_queue.push_back(n);
+		}
+	}
+}
+
+// calc lower bound of length to the nearest goal
+// quantized lengths a, b of a true length difference -> difference >= quantum * |a - b| - (quantum - 1)
+int landmarkLength(const Landmark &landmark, int cell, int col, const vector<int> &goal_cell) {
+	int length = INT_MAX;
+	int num = landmark.num;
+	const uint16_t *cell_dist = landmark.dist.data() + static_cast<size_t>(cell) * num;
+
+	Point cur_p(cell / col, cell % col);
+	for (uint i = 0; i < goal_cell.size(); i++) {
+		Point goal_p(goal_cell[i] / col, goal_cell[i] % col);
+		int bound = DISTANCE(cur_p, goal_p);
+
+		const uint16_t *goal_dist = landmark.dist.data() + static_cast<size_t>(goal_cell[i]) * num;
+		for (int l = 0; l < num; l++) {
+			if (cell_dist[l] == UNREACHED || goal_dist[l] == UNREACHED)
+				continue;
+
+			int diff = abs(static_cast<int>(cell_dist[l]) - static_cast<int>(goal_dist[l])) * landmark.quantum - (landmark.quantum - 1);
+			if (bound < diff)
+				bound = diff;
+		}
+
+		if (length > bound)
+			length = bound;
+	}
+
+	return length;
+}
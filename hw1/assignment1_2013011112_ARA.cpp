@@ -0,0 +1,625 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// epsilon fixed point scale -> score = length * EPSILON_SCALE + epsilon * length to goal
+#define EPSILON_SCALE 10
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell index
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+} OpenNode;
+
+// open list -> indexed 4-ary min heap of open nodes
+// pos keeps heap position of every cell (-1 -> not in heap) for decrease-key
+typedef struct OpenHeap {
+	OpenHeap(int);
+	bool empty() const;
+	int size() const;
+	bool contains(int) const;
+	const OpenNode &top() const;
+	const OpenNode &at(int) const;
+	void push(const OpenNode &);
+	void pop();
+	void clear();
+	void decreaseKey(int, int);
+	void siftUp(int);
+	void siftDown(int);
+
+	vector<OpenNode> heap;
+	vector<int> pos;
+} OpenHeap;
+
+// result info -> length, time, suboptimality bound, epsilon of last finished improve step, number of finished improve steps, elapsed ms
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+	double bound;
+	int epsilon;
+	int iterations;
+	double search_ms;
+} Result;
+
+// search budget -> 0 means no limit
+typedef struct Budget {
+	Budget();
+
+	double time_ms;
+	long long max_expansions;
+	int epsilon;
+	int epsilon_step;
+} Budget;
+
+// improved solution info -> epsilon of the step, length, expanded cells and elapsed ms so far
+typedef struct Solution {
+	Solution(int, int, int, double);
+
+	int epsilon;
+	int length;
+	int time;
+	double ms;
+} Solution;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+// heap size is bounded by cell_num
+OpenHeap::OpenHeap(int cell_num)
+	: pos(cell_num, -1) {}
+
+bool OpenHeap::empty() const {
+	return heap.empty();
+}
+
+int OpenHeap::size() const {
+	return static_cast<int>(heap.size());
+}
+
+bool OpenHeap::contains(int cell) const {
+	return pos[cell] != -1;
+}
+
+const OpenNode &OpenHeap::top() const {
+	return heap[0];
+}
+
+const OpenNode &OpenHeap::at(int cell) const {
+	return heap[pos[cell]];
+}
+
+void OpenHeap::push(const OpenNode &node) {
+	heap.push_back(node);
+	siftUp(size() - 1);
+}
+
+void OpenHeap::pop() {
+	pos[heap[0].cell] = -1;
+
+	OpenNode last = heap.back();
+	heap.pop_back();
+	if (!heap.empty()) {
+		heap[0] = last;
+		siftDown(0);
+	}
+}
+
+// remove remaining nodes -> pos of every cell is -1 again
+void OpenHeap::clear() {
+	for (uint i = 0; i < heap.size(); i++)
+		pos[heap[i].cell] = -1;
+	heap.clear();
+}
+
+// set smaller score of cell in heap
+void OpenHeap::decreaseKey(int cell, int score) {
+	int i = pos[cell];
+	heap[i].score = score;
+	siftUp(i);
+}
+
+void OpenHeap::siftUp(int i) {
+	OpenNode node = heap[i];
+
+	while (i > 0) {
+		int parent = (i - 1) / 4;
+		if (!(heap[parent] > node))
+			break;
+
+		heap[i] = heap[parent];
+		pos[heap[i].cell] = i;
+		i = parent;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+void OpenHeap::siftDown(int i) {
+	OpenNode node = heap[i];
+	int n = size();
+
+	while (true) {
+		int first_child = 4 * i + 1;
+		if (first_child >= n)
+			break;
+
+		// smallest of up to 4 children
+		int best = first_child;
+		int last_child = min(first_child + 4, n);
+		for (int c = first_child + 1; c < last_child; c++)
+			if (heap[best] > heap[c])
+				best = c;
+
+		if (!(node > heap[best]))
+			break;
+
+		heap[i] = heap[best];
+		pos[heap[i].cell] = i;
+		i = best;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+Result::Result()
+	: length(0), time(0), bound(0.0), epsilon(0), iterations(0), search_ms(0.0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_), bound(0.0), epsilon(0), iterations(0), search_ms(0.0) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+	bound = res.bound;
+	epsilon = res.epsilon;
+	iterations = res.iterations;
+	search_ms = res.search_ms;
+
+	return *this;
+}
+
+Budget::Budget()
+	: time_ms(0.0), max_expansions(0), epsilon(3 * EPSILON_SCALE), epsilon_step(EPSILON_SCALE / 2) {}
+
+Solution::Solution(int epsilon_, int length_, int time_, double ms_)
+	: epsilon(epsilon_), length(length_), time(time_), ms(ms_) {}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+Result calc(Map **, int, int, Point &, vector<Point> &, const Budget &, vector<Solution> &);
+int shortestLength(int, int, vector<Point> &);
+
+// usage: ./ARA [budget_ms] [max_expansions] [epsilon] [epsilon_step]
+// first solution with weighted A* (epsilon 3.0 by default), then improve it while epsilon decreases
+// by epsilon_step (0.5 by default) to 1.0, budget 0 -> no limit
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// search budget and epsilon schedule
+	Budget budget;
+	if (argc > 1)
+		budget.time_ms = atof(argv[1]);
+	if (argc > 2)
+		budget.max_expansions = atoll(argv[2]);
+	if (argc > 3)
+		budget.epsilon = static_cast<int>(atof(argv[3]) * EPSILON_SCALE + 0.5);
+	if (argc > 4)
+		budget.epsilon_step = static_cast<int>(atof(argv[4]) * EPSILON_SCALE + 0.5);
+
+	if (budget.time_ms < 0.0 || budget.max_expansions < 0 || budget.epsilon < EPSILON_SCALE || budget.epsilon_step <= 0) {
+		cerr << "budget or epsilon value error" << endl;
+		return -1;
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	Point start;
+	vector<Point> goal;
+	Result result;
+	vector<Solution> solution;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// calc best result in budget
+	result = calc(map_info, row, col, start, goal, budget, solution);
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// best result
+	if (result.length != -1) {
+		output_f << "length=" << result.length << endl;
+		output_f << "time=" << result.time << endl;
+	}
+	// no result
+	else {
+		output_f << "time=" << result.time << endl;
+		output_f << "no result" << endl;
+	}
+
+	output_f << "bound=" << result.bound << endl;
+	output_f << "epsilon=" << static_cast<double>(result.epsilon) / EPSILON_SCALE << endl;
+	output_f << "iterations=" << result.iterations << endl;
+	output_f << "search_ms=" << result.search_ms << endl;
+	// every improved solution, first one first
+	for (uint i = 0; i < solution.size(); i++) {
+		output_f << "solution epsilon=" << static_cast<double>(solution[i].epsilon) / EPSILON_SCALE;
+		output_f << " length=" << solution[i].length;
+		output_f << " time=" << solution[i].time;
+		output_f << " ms=" << solution[i].ms << endl;
+	}
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// calc result road with anytime repairing A* (ARA*)
+// each improve step reuses length from start of every cell, cells improved after being
+// expanded in the step wait in the inconsistent list and go back to open list for the next step
+Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal, const Budget &budget, vector<Solution> &solution) {
+	Result res;
+	int cell_num = row * col;
+
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+
+	// per-cell length from start, parent cell index, cached length to goal
+	// and the improve step in which the cell was expanded
+	vector<int> length_from_start(cell_num, INT_MAX);
+	vector<int> parent(cell_num, -1);
+	vector<int> length_to_goal(cell_num, -1);
+	vector<int> closed_step(cell_num, -1);
+
+	// inconsistent list -> expanded cells whose length from start became shorter
+	vector<int> incons;
+	vector<uint8_t> in_incons(cell_num, 0);
+
+	const int DIR_ROW[4] = {-1, 0, 1, 0};
+	const int DIR_COL[4] = {0, 1, 0, -1};
+
+	int start_idx = start.row * col + start.col;
+	length_from_start[start_idx] = 0;
+	parent[start_idx] = start_idx;
+	length_to_goal[start_idx] = shortestLength(start.row, start.col, goal);
+
+	// search smallest score point first
+	int epsilon = budget.epsilon;
+	OpenHeap search_queue(cell_num);
+	search_queue.push(OpenNode(epsilon * length_to_goal[start_idx], length_to_goal[start_idx], start_idx));
+
+	int goal_idx = -1;
+	bool stopped = false;
+	int step = 0;
+
+	while (true) {
+		int prev_goal_length = (goal_idx != -1) ? length_from_start[goal_idx] : INT_MAX;
+
+		// improve step -> until no open cell can give a shorter road than the best goal
+		while (!search_queue.empty()) {
+			if (goal_idx != -1 && static_cast<long long>(length_from_start[goal_idx]) * EPSILON_SCALE <= search_queue.top().score)
+				break;
+
+			// check budget, clock is read once per 256 expansions
+			if (budget.max_expansions > 0 && res.time >= budget.max_expansions) {
+				stopped = true;
+				break;
+			}
+			if (budget.time_ms > 0.0 && (res.time & 0xFF) == 0 &&
+					chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count() >= budget.time_ms) {
+				stopped = true;
+				break;
+			}
+
+			int cur_idx = search_queue.top().cell;
+			search_queue.pop();
+
+			res.time++;
+			closed_step[cur_idx] = step;
+
+			// goal is the end of a road
+			int cur_row = cur_idx / col;
+			int cur_col = cur_idx % col;
+			if (map[cur_row][cur_col] == Map::GOAL)
+				continue;
+
+			int next_length = length_from_start[cur_idx] + 1;
+			for (int d = 0; d < 4; d++) {
+				int next_row = cur_row + DIR_ROW[d];
+				int next_col = cur_col + DIR_COL[d];
+				if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+					continue;
+
+				Map next_cell = map[next_row][next_col];
+				int n = next_row * col + next_col;
+				if ((next_cell != Map::ROAD && next_cell != Map::GOAL) || next_length >= length_from_start[n])
+					continue;
+
+				length_from_start[n] = next_length;
+				parent[n] = cur_idx;
+				if (next_cell == Map::GOAL && (goal_idx == -1 || next_length < length_from_start[goal_idx]))
+					goal_idx = n;
+
+				if (length_to_goal[n] == -1)
+					length_to_goal[n] = shortestLength(next_row, next_col, goal);
+
+				int score = next_length * EPSILON_SCALE + epsilon * length_to_goal[n];
+				if (closed_step[n] != step) {
+					if (!search_queue.contains(n))
+						search_queue.push(OpenNode(score, length_to_goal[n], n));
+					else
+						search_queue.decreaseKey(n, score);
+				}
+				else if (!in_incons[n]) {
+					in_incons[n] = 1;
+					incons.push_back(n);
+				}
+			}
+		}
+
+		double elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+		if (goal_idx != -1 && length_from_start[goal_idx] < prev_goal_length)
+			solution.emplace_back(epsilon, length_from_start[goal_idx] - 1, res.time, elapsed_ms);
+
+		// no result
+		if (goal_idx == -1 && !stopped)
+			break;
+
+		// epsilon bound holds only for a finished improve step
+		if (!stopped) {
+			res.iterations = step + 1;
+			res.epsilon = epsilon;
+		}
+
+		if (stopped || epsilon == EPSILON_SCALE)
+			break;
+
+		// next improve step -> smaller epsilon, inconsistent cells go back to open list
+		epsilon = max(EPSILON_SCALE, epsilon - budget.epsilon_step);
+		step++;
+
+		vector<int> open_cell;
+		open_cell.reserve(search_queue.size() + incons.size());
+		for (int i = 0; i < search_queue.size(); i++)
+			open_cell.push_back(search_queue.heap[i].cell);
+		for (uint i = 0; i < incons.size(); i++) {
+			open_cell.push_back(incons[i]);
+			in_incons[incons[i]] = 0;
+		}
+		incons.clear();
+
+		search_queue.clear();
+		for (uint i = 0; i < open_cell.size(); i++) {
+			int n = open_cell[i];
+			search_queue.push(OpenNode(length_from_start[n] * EPSILON_SCALE + epsilon * length_to_goal[n], length_to_goal[n], n));
+		}
+	}
+
+	res.search_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+	// make result road to start point from goal
+	if (goal_idx != -1) {
+		// suboptimality bound -> min(epsilon, best length / smallest length + length to goal of open cells)
+		int min_f = INT_MAX;
+		for (int i = 0; i < search_queue.size(); i++) {
+			int n = search_queue.heap[i].cell;
+			min_f = min(min_f, length_from_start[n] + length_to_goal[n]);
+		}
+		for (uint i = 0; i < incons.size(); i++)
+			min_f = min(min_f, length_from_start[incons[i]] + length_to_goal[incons[i]]);
+
+		res.bound = static_cast<double>(length_from_start[goal_idx]) / max(min_f, 1);
+		if (min_f == INT_MAX || min_f >= length_from_start[goal_idx])
+			res.bound = 1.0;
+		if (res.epsilon != 0)
+			res.bound = min(res.bound, static_cast<double>(res.epsilon) / EPSILON_SCALE);
+
+		res.length = length_from_start[goal_idx] - 1;
+		int track_road = parent[goal_idx];
+		while (track_road != start_idx) {
+			map[track_road / col][track_road % col] = Map::ROAD_G;
+			track_road = parent[track_road];
+		}
+	}
+	// no result
+	else
+		res.length = -1;
+
+	return res;
+}
+
+// calc shortest length to several goals
+int shortestLength(int row, int col, vector<Point> &goal) {
+	int length = INT_MAX;
+
+	Point cur_p(row, col);
+	for (uint i = 0; i < goal.size(); i++) {
+		int curLength = DISTANCE(cur_p, goal[i]);
+
+		if (length > curLength)
+			length = curLength;
+	}
+
+	return length;
+}
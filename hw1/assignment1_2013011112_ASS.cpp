@@ -3,11 +3,51 @@
 #include <string>
 #include <vector>
 #include <cmath>
-#include <queue>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// per-phase timers and search counters -> build with -DPROFILE to enable
+#ifdef PROFILE
+#include <chrono>
+#endif
+
+// expansion trace recorder -> build with -DTRACE to enable
+// the last TRACE_CAPACITY expansions are kept in a ring buffer allocated before the search
+#ifdef TRACE
+#include <cstdint>
+
+#ifndef TRACE_CAPACITY
+#define TRACE_CAPACITY (1 << 20)
+#endif
+#endif
+
+// move mode -> 4 direction (default) or 8 direction with -DMOVE_DIR=8
+#ifndef MOVE_DIR
+#define MOVE_DIR 4
+#endif
+
+// move cost -> 1 per move in 4 direction mode, 10/14 (straight/diagonal) in 8 direction mode
+#if MOVE_DIR == 8
+#define STRAIGHT_COST	10
+#define DIAGONAL_COST	14
+
+// calc octile distance
+#define DISTANCE(p1, p2)	(STRAIGHT_COST * max(abs(p1.row - p2.row), abs(p1.col - p2.col)) + \
+							 (DIAGONAL_COST - STRAIGHT_COST) * min(abs(p1.row - p2.row), abs(p1.col - p2.col)))
+#else
+#define STRAIGHT_COST	1
+#define DIAGONAL_COST	2
 
 // calc manhattan distance
 #define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
 							 abs(p1.col - p2.col))
+#endif
 
 using namespace std;
 
@@ -22,17 +62,35 @@ typedef struct Point {
 	int col;
 } Point;
 
-// node info -> point info, length data, child and parent node
-typedef struct Node {
-	Node(int, int, Node * = NULL, int = 0, int = 0);
+// open list node -> length from start + length to goal, length to goal, cell index
+// stored inline in the heap (12 bytes), length from start and parent are per-cell arrays
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
 
-	Point p;
-	int length_from_start;
+	int score;
 	int length_to_goal;
-
-	vector<Node *> child;
-	Node *parent;
-} Node;
+	int cell;
+} OpenNode;
+
+// open list -> indexed 4-ary min heap of open nodes
+// pos keeps heap position of every cell (-1 -> not in heap) for decrease-key
+typedef struct OpenHeap {
+	OpenHeap(int);
+	bool empty() const;
+	int size() const;
+	bool contains(int) const;
+	const OpenNode &top() const;
+	const OpenNode &at(int) const;
+	void push(const OpenNode &);
+	void pop();
+	void decreaseKey(int, int);
+	void siftUp(int);
+	void siftDown(int);
+
+	vector<OpenNode> heap;
+	vector<int> pos;
+} OpenHeap;
 
 typedef struct Result {
 	Result();
@@ -41,6 +99,7 @@ typedef struct Result {
 
 	int length;
 	int time;
+	int cost;
 } Result;
 
 // Map enum data
@@ -60,6 +119,12 @@ typedef enum class CheckMap {
 	GOAL = 3
 } CheckMap;
 
+// search engine -> A* over open heap, or fringe search with threshold iterations over a cell list
+typedef enum class Engine {
+	ASTAR = 0,
+	FRINGE = 1
+} Engine;
+
 Point::Point()
 	: row(-1), col(-1) {}
 
@@ -74,36 +139,122 @@ bool Point::operator!=(const Point &p) {
 	return (this->row != p.row || this->col != p.col);
 }
 
-Node::Node(int row_, int col_, Node *parent_, int length_from_start_, int length_to_goal_) {
-	p.row = row_;
-	p.col = col_;
-	length_from_start = length_from_start_;
-	length_to_goal = length_to_goal_;
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
 
-	// for root node
-	if (parent_ == NULL)
-		parent = this;
-	else
-		parent = parent_;
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+// heap size is bounded by cell_num
+OpenHeap::OpenHeap(int cell_num)
+	: pos(cell_num, -1) {}
+
+bool OpenHeap::empty() const {
+	return heap.empty();
+}
+
+int OpenHeap::size() const {
+	return static_cast<int>(heap.size());
+}
+
+bool OpenHeap::contains(int cell) const {
+	return pos[cell] != -1;
+}
+
+const OpenNode &OpenHeap::top() const {
+	return heap[0];
+}
+
+const OpenNode &OpenHeap::at(int cell) const {
+	return heap[pos[cell]];
+}
+
+void OpenHeap::push(const OpenNode &node) {
+	heap.push_back(node);
+	siftUp(size() - 1);
+}
+
+void OpenHeap::pop() {
+	pos[heap[0].cell] = -1;
+
+	OpenNode last = heap.back();
+	heap.pop_back();
+	if (!heap.empty()) {
+		heap[0] = last;
+		siftDown(0);
+	}
 }
 
-// compare score -> smaller length, bigger score
-struct Compare {
-	bool operator() (const Node *n1, const Node *n2) {
-		return n1->length_from_start + n1->length_to_goal > n2->length_from_start + n2->length_to_goal;
+// set smaller score of cell in heap
+void OpenHeap::decreaseKey(int cell, int score) {
+	int i = pos[cell];
+	heap[i].score = score;
+	siftUp(i);
+}
+
+void OpenHeap::siftUp(int i) {
+	OpenNode node = heap[i];
+
+	while (i > 0) {
+		int parent = (i - 1) / 4;
+		if (!(heap[parent] > node))
+			break;
+
+		heap[i] = heap[parent];
+		pos[heap[i].cell] = i;
+		i = parent;
 	}
-};
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+void OpenHeap::siftDown(int i) {
+	OpenNode node = heap[i];
+	int n = size();
+
+	while (true) {
+		int first_child = 4 * i + 1;
+		if (first_child >= n)
+			break;
+
+		// smallest of up to 4 children
+		int best = first_child;
+		int last_child = min(first_child + 4, n);
+		for (int c = first_child + 1; c < last_child; c++)
+			if (heap[best] > heap[c])
+				best = c;
+
+		if (!(node > heap[best]))
+			break;
+
+		heap[i] = heap[best];
+		pos[heap[i].cell] = i;
+		i = best;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
 
 // result info -> length, time
 Result::Result()
-	: length(0), time(0) {}
+	: length(0), time(0), cost(0) {}
 
 Result::Result(int length_, int time_)
-	: length(length_), time(time_) {}
+	: length(length_), time(time_), cost(0) {}
 
 Result Result::operator= (const Result &res) {
 	length = res.length;
 	time = res.time;
+	cost = res.cost;
 
 	return *this;
 }
@@ -111,13 +262,160 @@ Result Result::operator= (const Result &res) {
 int MAP_SIZE_ROW = 0;
 int MAP_SIZE_COL = 0;
 
+// move direction table -> UP, RIGHT, DOWN, LEFT, UP_RIGHT, DOWN_RIGHT, DOWN_LEFT, UP_LEFT
+// bit flag of direction d -> (1 << d), only first MOVE_DIR directions are used
+const int DIR_ROW[8] = {-1, 0, 1, 0, -1, 1, 1, -1};
+const int DIR_COL[8] = {0, 1, 0, -1, 1, 1, -1, -1};
+const int DIR_COST[8] = {STRAIGHT_COST, STRAIGHT_COST, STRAIGHT_COST, STRAIGHT_COST,
+						 DIAGONAL_COST, DIAGONAL_COST, DIAGONAL_COST, DIAGONAL_COST};
+
+// orthogonal sides of diagonal direction -> both must not be WALL (no corner cutting)
+const int DIR_SIDE[8] = {0, 0, 0, 0, 0x01 | 0x02, 0x04 | 0x02, 0x04 | 0x08, 0x01 | 0x08};
+
+// profile info -> phase time (ns) and search counters
+// every PROF_* macro expands to nothing without PROFILE
+#ifdef PROFILE
+typedef struct Profile {
+	long long parse_ns;
+	long long alloc_ns;
+	long long search_ns;
+	long long track_ns;
+	long long output_ns;
+
+	long long pushes;
+	long long pops;
+	long long reexpansions;
+	long long max_open;
+} Profile;
+
+Profile PROF;
+
+#define PROF_DECLARE(t)			chrono::steady_clock::time_point t = chrono::steady_clock::now()
+#define PROF_START(t)			(t = chrono::steady_clock::now())
+#define PROF_PHASE(phase, t)	(PROF.phase += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t).count())
+#define PROF_COUNT(counter)		(PROF.counter++)
+#define PROF_MAX(counter, v)	do { if (PROF.counter < static_cast<long long>(v)) PROF.counter = (v); } while (0)
+#define PROF_CLOSED(s, n)		vector<bool> s(n, false)
+#define PROF_EXPAND(s, idx)		do { PROF.pops++; if (s[idx]) PROF.reexpansions++; s[idx] = true; } while (0)
+#else
+#define PROF_DECLARE(t)
+#define PROF_START(t)
+#define PROF_PHASE(phase, t)
+#define PROF_COUNT(counter)
+#define PROF_MAX(counter, v)
+#define PROF_CLOSED(s, n)
+#define PROF_EXPAND(s, idx)
+#endif
+
+// trace record -> expanded cell, length from start (move cost), length to goal, open list size
+// 16 bytes per expansion, TRACE_EXPAND expands to nothing without TRACE
+#ifdef TRACE
+typedef struct TraceRecord {
+	uint32_t cell;
+	int32_t length_from_start;
+	int32_t length_to_goal;
+	uint32_t open_size;
+} TraceRecord;
+
+// trace file header, followed by
+//   TraceRecord record[record_num] -> oldest expansion first, older ones are overwritten in the ring
+typedef struct TraceHeader {
+	char magic[4];
+	int32_t row;
+	int32_t col;
+	uint32_t record_num;
+	uint64_t expansions;
+} TraceHeader;
+
+// ring buffer of trace records -> one store and one index update per expansion, no allocation
+typedef struct TraceRing {
+	TraceRing();
+	void push(int, int, int, size_t);
+	bool dump(const string &, int, int) const;
+
+	vector<TraceRecord> record;
+	uint32_t next;
+	uint64_t expansions;
+} TraceRing;
+
+TraceRing TRACE_RING;
+
+#define TRACE_EXPAND(idx, g, h, open)	TRACE_RING.push(idx, g, h, open)
+#else
+#define TRACE_EXPAND(idx, g, h, open)
+#endif
+
+#ifdef TRACE
+TraceRing::TraceRing()
+	: record(TRACE_CAPACITY), next(0), expansions(0) {}
+
+inline void TraceRing::push(int cell, int length_from_start, int length_to_goal, size_t open_size) {
+	TraceRecord &r = record[next];
+	r.cell = static_cast<uint32_t>(cell);
+	r.length_from_start = length_from_start;
+	r.length_to_goal = length_to_goal;
+	r.open_size = static_cast<uint32_t>(open_size);
+
+	if (++next == TRACE_CAPACITY)
+		next = 0;
+	expansions++;
+}
+
+// write header and kept records in expansion order
+bool TraceRing::dump(const string &filename, int row, int col) const {
+	TraceHeader header;
+	memcpy(header.magic, "TRC1", 4);
+	header.row = row;
+	header.col = col;
+	header.record_num = static_cast<uint32_t>(min<uint64_t>(expansions, TRACE_CAPACITY));
+	header.expansions = expansions;
+
+	ofstream trace_f(filename, ios::binary);
+	if (!trace_f.is_open())
+		return false;
+
+	// ring wrapped -> oldest kept record is at next
+	uint32_t first = (expansions > TRACE_CAPACITY) ? next : 0;
+	trace_f.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	trace_f.write(reinterpret_cast<const char *>(record.data() + first), sizeof(TraceRecord) * (header.record_num - first));
+	trace_f.write(reinterpret_cast<const char *>(record.data()), sizeof(TraceRecord) * first);
+
+	return trace_f.good();
+}
+#endif
+
+const char *ENGINE_NAME[] = {"astar", "fringe"};
+
 Result calc(Map **, int, int, Point &, vector<Point> &);
+Result calcFringe(Map **, int, int, Point &, vector<Point> &);
 int findPossibleMoves(Map **, CheckMap **, int, int, Point &);
+void openCell(OpenHeap &, vector<int> &, vector<int> &, int, int, int, vector<Point> &);
 int shortestLength(int, int, vector<Point> &);
 
-int main () {
+int FRINGE_ITERATIONS = 0;
+
+// usage: ./ASS [astar|fringe] -> search with the engine (astar by default)
+// fringe reports the same length, cost and counters, plus its threshold iterations
+int main (int argc, char *argv[]) {
 	string input_filename = "input.txt";
 	string output_filename = "output.txt";
+#ifdef TRACE
+	string trace_filename = "trace.bin";
+#endif
+	PROF_DECLARE(phase_t);
+
+	// engine option
+	int engine_i = 0;
+	if (argc > 1) {
+		while (engine_i < 2 && strcmp(ENGINE_NAME[engine_i], argv[1]) != 0)
+			engine_i++;
+		if (engine_i == 2) {
+			cerr << "unknown engine " << argv[1] << endl;
+			return -1;
+		}
+	}
+
+	Engine engine = static_cast<Engine>(engine_i);
 
 	// open input.txt
 	ifstream input_f(input_filename);
@@ -140,7 +438,7 @@ int main () {
 	int row = 0;
 	int col = 0;
 	input_f >> row >> col;
-	if (row <= 0 || row > 500 || col <= 0 || col > 500) {
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
 		cerr << "row or col value error" << endl;
 		return -1;
 	}
@@ -150,16 +448,19 @@ int main () {
 	MAP_SIZE_COL = col;
 
 	// allocate map array data
+	PROF_START(phase_t);
 	Map **map_info = NULL;
 	map_info = new Map *[row];
 	for (int i = 0; i < row; i++)
 		map_info[i] = new Map[col];
+	PROF_PHASE(alloc_ns, phase_t);
 
 	int map_1cell_data = 0;
 	int row_i = 0;
 	int col_j = 0;
 
 	// get map data from input.txt and fill map array data
+	PROF_START(phase_t);
 	Point start;
 	vector<Point> goal;
 	Result result;
@@ -222,10 +523,16 @@ int main () {
 		goto RELEASE_DATA;
 	}
 
+	PROF_PHASE(parse_ns, phase_t);
+
 	// calc best result
-	result = calc(map_info, row, col, start, goal);
+	if (engine == Engine::FRINGE)
+		result = calcFringe(map_info, row, col, start, goal);
+	else
+		result = calc(map_info, row, col, start, goal);
 
 	// write
+	PROF_START(phase_t);
 	for (int i = 0; i < row; i++) {
 		for (int j = 0; j < col; j++) {
 			output_f << static_cast<int>(map_info[i][j]) << " ";
@@ -238,6 +545,9 @@ int main () {
 	// best result
 	if (result.length != -1) {
 		output_f << "length=" << result.length << endl;
+#if MOVE_DIR == 8
+		output_f << "cost=" << result.cost << endl;
+#endif
 		output_f << "time=" << result.time << endl;
 	}
 	// no result
@@ -246,6 +556,30 @@ int main () {
 		output_f << "no result" << endl;
 	}
 
+	if (engine == Engine::FRINGE)
+		output_f << "iterations=" << FRINGE_ITERATIONS << endl;
+	PROF_PHASE(output_ns, phase_t);
+
+#ifdef PROFILE
+	// profile block
+	output_f << "---" << endl;
+	output_f << "parse_ns=" << PROF.parse_ns << endl;
+	output_f << "alloc_ns=" << PROF.alloc_ns << endl;
+	output_f << "search_ns=" << PROF.search_ns << endl;
+	output_f << "track_ns=" << PROF.track_ns << endl;
+	output_f << "output_ns=" << PROF.output_ns << endl;
+	output_f << "pushes=" << PROF.pushes << endl;
+	output_f << "pops=" << PROF.pops << endl;
+	output_f << "reexpansions=" << PROF.reexpansions << endl;
+	output_f << "max_open=" << PROF.max_open << endl;
+#endif
+
+#ifdef TRACE
+	// expansion trace next to output.txt -> render with ./HEAT
+	if (!TRACE_RING.dump(trace_filename, row, col))
+		cerr << "trace file cannot be written" << endl;
+#endif
+
 RELEASE_DATA:
 	input_f.close();
 	output_f.close();
@@ -259,10 +593,14 @@ RELEASE_DATA:
 
 // calc result road using greedy best-first search algorithm
 Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal) {
-	Node root(start.row, start.col);
 	CheckMap **search_map;
 	Result res;
-	vector<Node *> all_nodes;
+	PROF_DECLARE(phase_t);
+	PROF_CLOSED(expanded, row * col);
+
+	// per-cell length from start and parent cell index
+	vector<int> length_from_start(row * col, 0);
+	vector<int> parent(row * col, -1);
 
 	// make check map -> after searching, set to UNCHECKED
 	search_map = new CheckMap *[row];
@@ -279,135 +617,290 @@ Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal) {
 		search_map[goal[i].row][goal[i].col] = CheckMap::GOAL;
 
 	// search biggest score point first
-	priority_queue<Node *, vector<Node *>, Compare> search_queue;
-	search_queue.push(&root);
-	Node *goal_node = NULL;
+	int start_idx = start.row * col + start.col;
+	parent[start_idx] = start_idx;
+
+	// cell index offset of every direction
+	int dir_offset[8];
+	for (int d = 0; d < 8; d++)
+		dir_offset[d] = DIR_ROW[d] * col + DIR_COL[d];
+
+	OpenHeap search_queue(row * col);
+	search_queue.push(OpenNode(0, 0, start_idx));
+	PROF_COUNT(pushes);
+	int goal_idx = -1;
+	PROF_PHASE(alloc_ns, phase_t);
 
 	// search continuously until finding result
 	// search_queue is empty when there is no result
+	PROF_START(phase_t);
 	while (!search_queue.empty()) {
-		Node *cur_node = search_queue.top();
+		int cur_idx = search_queue.top().cell;
+		TRACE_EXPAND(cur_idx, length_from_start[cur_idx], search_queue.top().length_to_goal, search_queue.size());
 		search_queue.pop();
-		all_nodes.push_back(cur_node);
 
 		res.time++;
 
-		Point cur_p(cur_node->p.row, cur_node->p.col);
+		Point cur_p(cur_idx / col, cur_idx % col);
+		PROF_EXPAND(expanded, cur_idx);
 
 		// check if goal node
 		if (map[cur_p.row][cur_p.col] == Map::GOAL) {
-			goal_node = cur_node;
+			goal_idx = cur_idx;
 			break;
 		}
 
+		// closed set -> length from start of expanded cell is final
+		if (search_map[cur_p.row][cur_p.col] == CheckMap::UNCHECKED)
+			search_map[cur_p.row][cur_p.col] = CheckMap::CHECKED;
+
 		// search possible way
-		// bit flag -> 0x01(up), 0x02(right), 0x04(down), 0x08(left)
 		int move_flag = findPossibleMoves(map, search_map, row, col, cur_p);
 
-		// UP
-		if (move_flag & 0x01) {
-			Node *up_node = new Node(cur_p.row-1, cur_p.col, cur_node);
-			up_node->length_from_start = up_node->parent->length_from_start + 1;
-			up_node->length_to_goal = shortestLength(cur_p.row-1, cur_p.col, goal);
-			search_queue.push(up_node);
+		// open every possible direction from neighbour table
+		for (int d = 0; d < MOVE_DIR; d++) {
+			if (move_flag & (1 << d))
+				openCell(search_queue, length_from_start, parent, cur_idx, cur_idx + dir_offset[d],
+						length_from_start[cur_idx] + DIR_COST[d], goal);
 		}
 
-		// RIGHT
-		if (move_flag & 0x02) {
-			Node *right_node = new Node(cur_p.row, cur_p.col+1, cur_node);
-			right_node->length_from_start = right_node->parent->length_from_start + 1;
-			right_node->length_to_goal = shortestLength(cur_p.row, cur_p.col+1, goal);
-			search_queue.push(right_node);
-		}
+		PROF_MAX(max_open, search_queue.size());
+	}
+	PROF_PHASE(search_ns, phase_t);
 
-		// DOWN
-		if (move_flag & 0x04) {
-			Node *down_node = new Node(cur_p.row+1, cur_p.col, cur_node);
-			down_node->length_from_start = down_node->parent->length_from_start + 1;
-			down_node->length_to_goal = shortestLength(cur_p.row+1, cur_p.col, goal);
-			search_queue.push(down_node);
+	// make result road to start point from goal
+	PROF_START(phase_t);
+	if (goal_idx != -1) {
+		res.cost = length_from_start[goal_idx];
+		int track_road = parent[goal_idx];
+		while (track_road != start_idx) {
+			map[track_road / col][track_road % col] = Map::ROAD_G;
+			res.length++;
+
+			track_road = parent[track_road];
 		}
+	}
+	// no result
+	else
+		res.length = -1;
+	PROF_PHASE(track_ns, phase_t);
+
+	// free datum
+	PROF_START(phase_t);
+	for (int i = 0; i < row; i++)
+		delete[] search_map[i];
+	delete[] search_map;
+	PROF_PHASE(alloc_ns, phase_t);
+
+	return res;
+}
+
+// calc result road using fringe search
+// fringe is a doubly-linked list of cell indices with a sentinel, visited from head in every iteration
+// a cell within flimit is expanded and its children are linked right after it, so they are visited
+// in the same iteration, a cell over flimit waits and gives the next flimit (smallest score over flimit)
+// the first goal within flimit is optimal, no heap ordering is kept
+// length from start, length to goal and parent of every touched cell are cached between iterations
+Result calcFringe(Map **map, int row, int col, Point &start, vector<Point> &goal) {
+	CheckMap **search_map;
+	Result res;
+	PROF_DECLARE(phase_t);
+	PROF_CLOSED(expanded, row * col);
+
+	// per-cell cache -> length from start (INT_MAX unknown), length to goal (-1 unknown), parent cell index
+	int cell_num = row * col;
+	vector<int> length_from_start(cell_num, INT_MAX);
+	vector<int> length_to_goal(cell_num, -1);
+	vector<int> parent(cell_num, -1);
+
+	// fringe links, cell_num is the sentinel -> prev -1 when cell is not in fringe
+	vector<int> next(cell_num + 1, -1);
+	vector<int> prev(cell_num + 1, -1);
+
+	// make check map -> cells are never CHECKED, a shorter length puts a cell back in fringe
+	search_map = new CheckMap *[row];
+	for (int i = 0; i < row; i++) {
+		search_map[i] = new CheckMap[col];
 
-		// LEFT
-		if (move_flag & 0x08) {
-			Node *left_node = new Node(cur_p.row, cur_p.col-1, cur_node);
-			left_node->length_from_start = left_node->parent->length_from_start + 1;
-			left_node->length_to_goal = shortestLength(cur_p.row, cur_p.col-1, goal);
-			search_queue.push(left_node);
+		for (int j = 0; j < col; j++)
+			search_map[i][j] = CheckMap::UNCHECKED;
+	}
+
+	// set start and goal point
+	search_map[start.row][start.col] = CheckMap::START;
+	for (uint i = 0; i < goal.size(); i++)
+		search_map[goal[i].row][goal[i].col] = CheckMap::GOAL;
+
+	// fringe with start cell only
+	int head = cell_num;
+	int start_idx = start.row * col + start.col;
+	length_from_start[start_idx] = 0;
+	length_to_goal[start_idx] = shortestLength(start.row, start.col, goal);
+	parent[start_idx] = start_idx;
+	next[head] = start_idx;
+	prev[head] = start_idx;
+	next[start_idx] = head;
+	prev[start_idx] = head;
+	int fringe_size = 1;
+	PROF_COUNT(pushes);
+
+	// cell index offset of every direction
+	int dir_offset[8];
+	for (int d = 0; d < 8; d++)
+		dir_offset[d] = DIR_ROW[d] * col + DIR_COL[d];
+
+	int flimit = length_to_goal[start_idx];
+	int goal_idx = -1;
+	FRINGE_ITERATIONS = 0;
+	PROF_PHASE(alloc_ns, phase_t);
+
+	// iterate until finding result
+	// fringe is empty when there is no result
+	PROF_START(phase_t);
+	while (goal_idx == -1 && next[head] != head) {
+		int fmin = INT_MAX;
+		FRINGE_ITERATIONS++;
+
+		int cur_idx = next[head];
+		while (cur_idx != head) {
+			int score = length_from_start[cur_idx] + length_to_goal[cur_idx];
+			if (score > flimit) {
+				fmin = min(fmin, score);
+				cur_idx = next[cur_idx];
+				continue;
+			}
+
+			res.time++;
+			TRACE_EXPAND(cur_idx, length_from_start[cur_idx], length_to_goal[cur_idx], fringe_size);
+
+			Point cur_p(cur_idx / col, cur_idx % col);
+			PROF_EXPAND(expanded, cur_idx);
+
+			// check if goal node
+			if (map[cur_p.row][cur_p.col] == Map::GOAL) {
+				goal_idx = cur_idx;
+				break;
+			}
+
+			// search possible way
+			int move_flag = findPossibleMoves(map, search_map, row, col, cur_p);
+
+			// link children after current cell in reverse order -> visited next in direction order
+			for (int d = MOVE_DIR - 1; d >= 0; d--) {
+				if (!(move_flag & (1 << d)))
+					continue;
+
+				int next_idx = cur_idx + dir_offset[d];
+				int next_length = length_from_start[cur_idx] + DIR_COST[d];
+				if (next_length >= length_from_start[next_idx])
+					continue;
+
+				length_from_start[next_idx] = next_length;
+				parent[next_idx] = cur_idx;
+				if (length_to_goal[next_idx] == -1)
+					length_to_goal[next_idx] = shortestLength(next_idx / col, next_idx % col, goal);
+
+				// unlink from old place in fringe
+				if (prev[next_idx] != -1) {
+					next[prev[next_idx]] = next[next_idx];
+					prev[next[next_idx]] = prev[next_idx];
+				}
+				else
+					fringe_size++;
+
+				prev[next_idx] = cur_idx;
+				next[next_idx] = next[cur_idx];
+				prev[next[cur_idx]] = next_idx;
+				next[cur_idx] = next_idx;
+				PROF_COUNT(pushes);
+			}
+
+			PROF_MAX(max_open, fringe_size);
+
+			// unlink current cell and go on with its first child
+			int following = next[cur_idx];
+			next[prev[cur_idx]] = following;
+			prev[following] = prev[cur_idx];
+			prev[cur_idx] = -1;
+			fringe_size--;
+
+			cur_idx = following;
 		}
+
+		flimit = fmin;
 	}
+	PROF_PHASE(search_ns, phase_t);
 
 	// make result road to start point from goal
-	if (goal_node) {
-		Node *track_road = goal_node->parent;
-		while (track_road->p != start) {
-			map[track_road->p.row][track_road->p.col] = Map::ROAD_G;
+	PROF_START(phase_t);
+	if (goal_idx != -1) {
+		res.cost = length_from_start[goal_idx];
+		int track_road = parent[goal_idx];
+		while (track_road != start_idx) {
+			map[track_road / col][track_road % col] = Map::ROAD_G;
 			res.length++;
 
-			track_road = track_road->parent;
+			track_road = parent[track_road];
 		}
 	}
 	// no result
 	else
 		res.length = -1;
+	PROF_PHASE(track_ns, phase_t);
 
 	// free datum
+	PROF_START(phase_t);
 	for (int i = 0; i < row; i++)
 		delete[] search_map[i];
 	delete[] search_map;
+	PROF_PHASE(alloc_ns, phase_t);
 
-	// all_nodes[0] -> root node
-	for (uint i = 1; i < all_nodes.size(); i++)
-		delete all_nodes[i];
-	
-	while (!search_queue.empty()) {
-		Node *delete_node = search_queue.top();
-		search_queue.pop();
+	return res;
+}
 
-		delete delete_node;
+// push next cell to open list or decrease its score when shorter road is found
+void openCell(OpenHeap &search_queue, vector<int> &length_from_start, vector<int> &parent,
+		int cur_idx, int next_idx, int next_length, vector<Point> &goal) {
+	if (!search_queue.contains(next_idx)) {
+		int length_to_goal = shortestLength(next_idx / MAP_SIZE_COL, next_idx % MAP_SIZE_COL, goal);
+		length_from_start[next_idx] = next_length;
+		parent[next_idx] = cur_idx;
+		search_queue.push(OpenNode(next_length + length_to_goal, length_to_goal, next_idx));
+		PROF_COUNT(pushes);
+	}
+	else if (next_length < length_from_start[next_idx]) {
+		length_from_start[next_idx] = next_length;
+		parent[next_idx] = cur_idx;
+		search_queue.decreaseKey(next_idx, next_length + search_queue.at(next_idx).length_to_goal);
 	}
-
-	return res;
 }
 
 // find possible direction from current point
+// bit flag -> 0x01(up), 0x02(right), 0x04(down), 0x08(left)
+//             0x10(up-right), 0x20(down-right), 0x40(down-left), 0x80(up-left) in 8 direction mode
 int findPossibleMoves(Map **map, CheckMap **search_map, int row, int col, Point &p) {
 	int result = 0;
+	int side_flag = 0;
 
-	// UP
-	if (p.row > 0 && 
-			(map[p.row-1][p.col] == Map::ROAD || map[p.row-1][p.col] == Map::GOAL) &&
-			(search_map[p.row-1][p.col] == CheckMap::UNCHECKED || search_map[p.row-1][p.col] == CheckMap::GOAL)) {
+	// orthogonal directions come first -> side_flag is ready for diagonal directions
+	for (int d = 0; d < MOVE_DIR; d++) {
+		int next_row = p.row + DIR_ROW[d];
+		int next_col = p.col + DIR_COL[d];
+		if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+			continue;
 
-		result |= 0x01;
-		search_map[p.row-1][p.col] = CheckMap::CHECKED;
-	}
+		Map next_cell = map[next_row][next_col];
+		if (next_cell != Map::WALL)
+			side_flag |= (1 << d);
 
-	// RIGHT
-	if (p.col < MAP_SIZE_COL - 1 && 
-			(map[p.row][p.col+1] == Map::ROAD || map[p.row][p.col+1] == Map::GOAL) &&
-			(search_map[p.row][p.col+1] == CheckMap::UNCHECKED || search_map[p.row][p.col+1] == CheckMap::GOAL)) {
+		if ((side_flag & DIR_SIDE[d]) != DIR_SIDE[d])
+			continue;
 
-		result |= 0x02;
-		search_map[p.row][p.col+1] = CheckMap::CHECKED;
-	}
-
-	// DOWN
-	if (p.row < MAP_SIZE_ROW - 1 && 
-			(map[p.row+1][p.col] == Map::ROAD || map[p.row+1][p.col] == Map::GOAL) &&
-			(search_map[p.row+1][p.col] == CheckMap::UNCHECKED || search_map[p.row+1][p.col] == CheckMap::GOAL)) {
-
-		result |= 0x04;
-		search_map[p.row+1][p.col] = CheckMap::CHECKED;
-	}
-
-	// LEFT
-	if (p.col > 0 && 
-			(map[p.row][p.col-1] == Map::ROAD || map[p.row][p.col-1] == Map::GOAL) &&
-			(search_map[p.row][p.col-1] == CheckMap::UNCHECKED || search_map[p.row][p.col-1] == CheckMap::GOAL)) {
+		if ((next_cell == Map::ROAD || next_cell == Map::GOAL) &&
+				(search_map[next_row][next_col] == CheckMap::UNCHECKED || search_map[next_row][next_col] == CheckMap::GOAL)) {
 
-		result |= 0x08;
-		search_map[p.row][p.col-1] = CheckMap::CHECKED;
+			result |= (1 << d);
+		}
 	}
 
 	return result;
@@ -415,7 +908,7 @@ int findPossibleMoves(Map **map, CheckMap **search_map, int row, int col, Point
 
 // calc shortest length to several goals
 int shortestLength(int row, int col, vector<Point> &goal) {
-	int length = MAP_SIZE_ROW + MAP_SIZE_COL;
+	int length = INT_MAX;
 
 	Point cur_p(row, col);
 	for (uint i = 0; i < goal.size(); i++) {
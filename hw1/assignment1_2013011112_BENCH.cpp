@@ -0,0 +1,459 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+using namespace std;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// synthetic map kind
+typedef enum class MapType {
+	RANDOM = 0,
+	MAZE = 1,
+	ROOMS = 2,
+	CORRIDOR = 3
+} MapType;
+
+// benchmark options -> solver binaries, map kinds, map sizes, trials
+typedef struct BenchOption {
+	BenchOption();
+
+	vector<string> solver;
+	vector<MapType> type;
+	vector<int> size;
+	int trials;
+	int goals;
+	double density;
+	unsigned int seed;
+	string work_dir;
+} BenchOption;
+
+// one solver run info -> wall time, peak rss, output of solver
+typedef struct RunResult {
+	RunResult();
+
+	bool ok;
+	double ms;
+	long peak_rss_kb;
+	long long time;
+	int length;
+} RunResult;
+
+BenchOption::BenchOption()
+	: trials(5), goals(1), density(0.3), seed(1), work_dir("bench_work") {}
+
+RunResult::RunResult()
+	: ok(false), ms(0.0), peak_rss_kb(0), time(0), length(-1) {}
+
+const char *TYPE_NAME[] = {"random", "maze", "rooms", "corridor"};
+
+void generateMap(vector<Map> &, MapType, int, double, int, mt19937 &);
+bool writeMap(const string &, const vector<Map> &, int);
+RunResult runSolver(const string &, const string &);
+double percentile(vector<double> &, double);
+
+// usage:
+//   ./BENCH gen <type> <size> [seed] [density] [goals] -> write input.txt only
+//   ./BENCH [-t random,maze,rooms,corridor] [-s 100,1000] [-n trials] [-seed S]
+//           [-d density] [-g goals] [-w work_dir] solver_binary...
+// solvers are the assignment programs built with -DMAX_MAP_SIZE=10000
+// one csv line per (solver, map type, size) is written to stdout
+int main (int argc, char *argv[]) {
+	BenchOption opt;
+
+	// generator only mode
+	if (argc > 1 && strcmp(argv[1], "gen") == 0) {
+		if (argc < 4) {
+			cerr << "gen <type> <size> [seed] [density] [goals]" << endl;
+			return -1;
+		}
+
+		int type_i = 0;
+		while (type_i < 4 && strcmp(TYPE_NAME[type_i], argv[2]) != 0)
+			type_i++;
+		int size = atoi(argv[3]);
+		if (type_i == 4 || size < 5) {
+			cerr << "map type or size value error" << endl;
+			return -1;
+		}
+
+		if (argc > 4)
+			opt.seed = static_cast<unsigned int>(strtoul(argv[4], NULL, 10));
+		if (argc > 5)
+			opt.density = atof(argv[5]);
+		if (argc > 6)
+			opt.goals = atoi(argv[6]);
+
+		mt19937 rng(opt.seed);
+		vector<Map> map;
+		generateMap(map, static_cast<MapType>(type_i), size, opt.density, opt.goals, rng);
+		if (!writeMap("input.txt", map, size)) {
+			cerr << "input file cannot be written" << endl;
+			return -1;
+		}
+
+		return 0;
+	}
+
+	// read options
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool has_value = (i + 1 < argc);
+
+		if (arg == "-t" && has_value) {
+			opt.type.clear();
+			stringstream ss(argv[++i]);
+			string name;
+			while (getline(ss, name, ',')) {
+				int type_i = 0;
+				while (type_i < 4 && name != TYPE_NAME[type_i])
+					type_i++;
+				if (type_i == 4) {
+					cerr << "unknown map type " << name << endl;
+					return -1;
+				}
+
+				opt.type.push_back(static_cast<MapType>(type_i));
+			}
+		}
+		else if (arg == "-s" && has_value) {
+			opt.size.clear();
+			stringstream ss(argv[++i]);
+			string value;
+			while (getline(ss, value, ','))
+				opt.size.push_back(atoi(value.c_str()));
+		}
+		else if (arg == "-n" && has_value)
+			opt.trials = atoi(argv[++i]);
+		else if (arg == "-seed" && has_value)
+			opt.seed = static_cast<unsigned int>(strtoul(argv[++i], NULL, 10));
+		else if (arg == "-d" && has_value)
+			opt.density = atof(argv[++i]);
+		else if (arg == "-g" && has_value)
+			opt.goals = atoi(argv[++i]);
+		else if (arg == "-w" && has_value)
+			opt.work_dir = argv[++i];
+		else if (arg[0] == '-') {
+			cerr << "unknown option " << arg << endl;
+			return -1;
+		}
+		else {
+			// solvers run inside work_dir -> keep absolute path
+			char resolved[PATH_MAX];
+			if (realpath(arg.c_str(), resolved) == NULL) {
+				cerr << "solver binary is not exist: " << arg << endl;
+				return -1;
+			}
+
+			opt.solver.push_back(resolved);
+		}
+	}
+
+	if (opt.type.empty())
+		for (int i = 0; i < 4; i++)
+			opt.type.push_back(static_cast<MapType>(i));
+	if (opt.size.empty()) {
+		opt.size.push_back(100);
+		opt.size.push_back(1000);
+	}
+
+	if (opt.solver.empty() || opt.trials <= 0 || opt.goals <= 0 || opt.density < 0.0 || opt.density >= 1.0) {
+		cerr << "solver or option value error" << endl;
+		return -1;
+	}
+
+	for (uint i = 0; i < opt.size.size(); i++) {
+		if (opt.size[i] < 5 || opt.size[i] > 10000) {
+			cerr << "map size must be in 5 ~ 10000" << endl;
+			return -1;
+		}
+	}
+
+	mkdir(opt.work_dir.c_str(), 0755);
+	string input_path = opt.work_dir + "/input.txt";
+
+	cout << "solver,map,size,seed,trials,length,expansions,median_ms,p99_ms,nodes_per_sec,peak_rss_kb" << endl;
+
+	for (uint t = 0; t < opt.type.size(); t++) {
+		for (uint s = 0; s < opt.size.size(); s++) {
+			// same seed -> same map for every solver
+			mt19937 rng(opt.seed);
+			vector<Map> map;
+			generateMap(map, opt.type[t], opt.size[s], opt.density, opt.goals, rng);
+			if (!writeMap(input_path, map, opt.size[s])) {
+				cerr << "input file cannot be written" << endl;
+				return -1;
+			}
+
+			for (uint v = 0; v < opt.solver.size(); v++) {
+				vector<double> ms;
+				RunResult run;
+				long peak_rss_kb = 0;
+
+				for (int n = 0; n < opt.trials; n++) {
+					run = runSolver(opt.solver[v], opt.work_dir);
+					if (!run.ok)
+						break;
+
+					ms.push_back(run.ms);
+					peak_rss_kb = max(peak_rss_kb, run.peak_rss_kb);
+				}
+
+				string solver_name = opt.solver[v].substr(opt.solver[v].find_last_of('/') + 1);
+				if (!run.ok) {
+					cerr << solver_name << " failed on " << TYPE_NAME[static_cast<int>(opt.type[t])]
+						<< " " << opt.size[s] << endl;
+					continue;
+				}
+
+				double median_ms = percentile(ms, 0.5);
+				double p99_ms = percentile(ms, 0.99);
+
+				cout << solver_name << ","
+					<< TYPE_NAME[static_cast<int>(opt.type[t])] << ","
+					<< opt.size[s] << ","
+					<< opt.seed << ","
+					<< opt.trials << ","
+					<< run.length << ","
+					<< run.time << ","
+					<< median_ms << ","
+					<< p99_ms << ","
+					<< static_cast<long long>(run.time / (median_ms / 1000.0 > 0.0 ? median_ms / 1000.0 : 1e-9)) << ","
+					<< peak_rss_kb << endl;
+			}
+		}
+	}
+
+	return 0;
+}
+
+// make size x size map of the given kind, 1 start and goal_num goals
+void generateMap(vector<Map> &map, MapType type, int size, double density, int goal_num, mt19937 &rng) {
+	uniform_real_distribution<double> prob(0.0, 1.0);
+	map.assign(static_cast<size_t>(size) * size, Map::ROAD);
+
+	switch (type) {
+		// walls scattered with the given density
+		case MapType::RANDOM:
+			for (size_t i = 0; i < map.size(); i++)
+				if (prob(rng) < density)
+					map[i] = Map::WALL;
+			break;
+
+		// perfect maze on odd cells -> recursive backtracker with explicit stack
+		case MapType::MAZE: {
+			fill(map.begin(), map.end(), Map::WALL);
+
+			int cell_row = (size - 1) / 2;
+			int cell_col = (size - 1) / 2;
+			vector<char> visited(static_cast<size_t>(cell_row) * cell_col, 0);
+			vector<int> stack;
+
+			stack.push_back(0);
+			visited[0] = 1;
+			map[1 * size + 1] = Map::ROAD;
+
+			const int dr[4] = {-1, 0, 1, 0};
+			const int dc[4] = {0, 1, 0, -1};
+			while (!stack.empty()) {
+				int cur = stack.back();
+				int r = cur / cell_col;
+				int c = cur % cell_col;
+
+				int next_dir[4];
+				int next_num = 0;
+				for (int d = 0; d < 4; d++) {
+					int nr = r + dr[d];
+					int nc = c + dc[d];
+					if (nr >= 0 && nr < cell_row && nc >= 0 && nc < cell_col && !visited[nr * cell_col + nc])
+						next_dir[next_num++] = d;
+				}
+
+				if (next_num == 0) {
+					stack.pop_back();
+					continue;
+				}
+
+				int d = next_dir[rng() % next_num];
+				int nr = r + dr[d];
+				int nc = c + dc[d];
+				visited[nr * cell_col + nc] = 1;
+
+				// open the wall between two cells and the next cell
+				map[(2 * r + 1 + dr[d]) * size + (2 * c + 1 + dc[d])] = Map::ROAD;
+				map[(2 * nr + 1) * size + (2 * nc + 1)] = Map::ROAD;
+				stack.push_back(nr * cell_col + nc);
+			}
+			break;
+		}
+
+		// open rooms separated by walls, every wall segment has one door
+		case MapType::ROOMS: {
+			int room = max(8, size / 10);
+
+			for (int r = room; r < size; r += room)
+				for (int c = 0; c < size; c++)
+					map[static_cast<size_t>(r) * size + c] = Map::WALL;
+			for (int c = room; c < size; c += room)
+				for (int r = 0; r < size; r++)
+					map[static_cast<size_t>(r) * size + c] = Map::WALL;
+
+			for (int r = 0; r < size; r += room) {
+				for (int c = 0; c < size; c += room) {
+					int h = min(room, size - r);
+					int w = min(room, size - c);
+
+					// door on the bottom wall and the right wall of each room
+					if (r + room < size && w > 1)
+						map[static_cast<size_t>(r + room) * size + c + 1 + rng() % (w - 1)] = Map::ROAD;
+					if (c + room < size && h > 1)
+						map[static_cast<size_t>(r + 1 + rng() % (h - 1)) * size + c + room] = Map::ROAD;
+				}
+			}
+			break;
+		}
+
+		// 1-wide horizontal corridors, connected at alternating ends
+		case MapType::CORRIDOR:
+			for (int r = 1; r < size; r += 2) {
+				for (int c = 0; c < size; c++)
+					map[static_cast<size_t>(r) * size + c] = Map::WALL;
+
+				if ((r / 2) % 2 == 0)
+					map[static_cast<size_t>(r) * size + size - 1] = Map::ROAD;
+				else
+					map[static_cast<size_t>(r) * size] = Map::ROAD;
+			}
+			break;
+	}
+
+	// pick a road cell inside [r0, r1) x [c0, c1), scan the area when sampling fails
+	auto pickRoad = [&](int r0, int r1, int c0, int c1) -> size_t {
+		for (int i = 0; i < 1000; i++) {
+			size_t idx = static_cast<size_t>(r0 + rng() % (r1 - r0)) * size + c0 + rng() % (c1 - c0);
+			if (map[idx] == Map::ROAD)
+				return idx;
+		}
+
+		for (int r = r0; r < r1; r++)
+			for (int c = c0; c < c1; c++)
+				if (map[static_cast<size_t>(r) * size + c] == Map::ROAD)
+					return static_cast<size_t>(r) * size + c;
+
+		return static_cast<size_t>(r0) * size + c0;
+	};
+
+	// start on the top-left quarter, goals on the bottom-right quarter
+	int quarter = max(1, size / 4);
+	map[pickRoad(0, quarter, 0, quarter)] = Map::START;
+	for (int i = 0; i < goal_num; i++)
+		map[pickRoad(size - quarter, size, size - quarter, size)] = Map::GOAL;
+}
+
+// write map to input file format
+bool writeMap(const string &filename, const vector<Map> &map, int size) {
+	ofstream output_f(filename);
+	if (!output_f.is_open())
+		return false;
+
+	output_f << size << " " << size << "\n";
+
+	string line;
+	for (int r = 0; r < size; r++) {
+		line.clear();
+		for (int c = 0; c < size; c++) {
+			line.push_back(static_cast<char>('0' + static_cast<int>(map[static_cast<size_t>(r) * size + c])));
+			line.push_back(c == size - 1 ? '\n' : ' ');
+		}
+
+		output_f << line;
+	}
+
+	output_f.close();
+
+	return !output_f.fail();
+}
+
+// run solver inside work_dir, measure wall time and peak rss and read its output.txt
+RunResult runSolver(const string &solver, const string &work_dir) {
+	RunResult res;
+
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+
+	pid_t pid = fork();
+	if (pid < 0)
+		return res;
+
+	if (pid == 0) {
+		if (chdir(work_dir.c_str()) != 0)
+			_exit(127);
+
+		execl(solver.c_str(), solver.c_str(), static_cast<char *>(NULL));
+		_exit(127);
+	}
+
+	int status = 0;
+	struct rusage usage;
+	if (wait4(pid, &status, 0, &usage) < 0)
+		return res;
+
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		return res;
+
+	res.ms = chrono::duration<double, milli>(end - begin).count();
+	res.peak_rss_kb = usage.ru_maxrss;
+
+	// length= and time= lines after ---
+	ifstream output_f(work_dir + "/output.txt");
+	if (!output_f.is_open())
+		return res;
+
+	string line;
+	bool after_map = false;
+	while (getline(output_f, line)) {
+		if (line == "---")
+			after_map = true;
+		else if (after_map && line.compare(0, 7, "length=") == 0)
+			res.length = atoi(line.c_str() + 7);
+		else if (after_map && line.compare(0, 5, "time=") == 0)
+			res.time = atoll(line.c_str() + 5);
+	}
+
+	res.ok = after_map;
+
+	return res;
+}
+
+// nearest-rank percentile, p in (0, 1]
+double percentile(vector<double> &value, double p) {
+	sort(value.begin(), value.end());
+
+	size_t rank = static_cast<size_t>(p * value.size() + 0.999999);
+	if (rank == 0)
+		rank = 1;
+	if (rank > value.size())
+		rank = value.size();
+
+	return value[rank - 1];
+}
@@ -0,0 +1,582 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include <chrono>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell index
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+} OpenNode;
+
+// agent result info -> length, arrival time, number of waits, expanded states, road cells
+typedef struct AgentResult {
+	AgentResult();
+
+	int length;
+	int arrival;
+	int waits;
+	int time;
+	vector<int> road;
+} AgentResult;
+
+// space-time search node -> cell, time, parent node index
+typedef struct StateNode {
+	StateNode(int, int, int);
+
+	int cell;
+	int t;
+	int parent;
+} StateNode;
+
+// open addressing hash table of 64-bit keys -> int values, linear probing
+// clear() only bumps the generation, slots of an old generation count as empty
+typedef struct HashTable {
+	HashTable(int);
+	const int *find(uint64_t) const;
+	void insert(uint64_t, int);
+	void clear();
+	void grow();
+
+	vector<uint64_t> key;
+	vector<int> value;
+	vector<uint32_t> stamp;
+	uint32_t generation;
+	int count;
+	int mask;
+} HashTable;
+
+// search buffers -> reused for every agent of the batch
+typedef struct SearchBuffer {
+	SearchBuffer(int);
+
+	vector<int> dist;
+	vector<int> bfs_queue;
+	vector<StateNode> node;
+	HashTable visited;
+} SearchBuffer;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+AgentResult::AgentResult()
+	: length(-1), arrival(-1), waits(0), time(0) {}
+
+StateNode::StateNode(int cell_, int t_, int parent_)
+	: cell(cell_), t(t_), parent(parent_) {}
+
+// capacity is a power of 2
+HashTable::HashTable(int capacity)
+	: generation(1), count(0) {
+	int size = 16;
+	while (size < capacity)
+		size <<= 1;
+
+	key.assign(size, 0);
+	value.assign(size, 0);
+	stamp.assign(size, 0);
+	mask = size - 1;
+}
+
+static inline uint64_t hashKey(uint64_t k) {
+	k ^= k >> 33;
+	k *= 0xFF51AFD7ED558CCDULL;
+	k ^= k >> 33;
+
+	return k;
+}
+
+// return pointer to value of key, NULL when key is not in the table
+const int *HashTable::find(uint64_t k) const {
+	for (uint64_t i = hashKey(k) & mask; stamp[i] == generation; i = (i + 1) & mask)
+		if (key[i] == k)
+			return &value[i];
+
+	return NULL;
+}
+
+// insert or overwrite value of key
+void HashTable::insert(uint64_t k, int v) {
+	if ((count + 1) * 2 > mask + 1)
+		grow();
+
+	uint64_t i = hashKey(k) & mask;
+	for (; stamp[i] == generation; i = (i + 1) & mask) {
+		if (key[i] == k) {
+			value[i] = v;
+			return;
+		}
+	}
+
+	key[i] = k;
+	value[i] = v;
+	stamp[i] = generation;
+	count++;
+}
+
+void HashTable::clear() {
+	count = 0;
+	generation++;
+
+	// stamp wraparound -> every slot is empty again
+	if (generation == 0) {
+		fill(stamp.begin(), stamp.end(), 0);
+		generation = 1;
+	}
+}
+
+// double capacity and move entries of current generation
+void HashTable::grow() {
+	vector<uint64_t> old_key;
+	vector<int> old_value;
+	vector<uint32_t> old_stamp;
+	old_key.swap(key);
+	old_value.swap(value);
+	old_stamp.swap(stamp);
+
+	int size = (mask + 1) * 2;
+	key.assign(size, 0);
+	value.assign(size, 0);
+	stamp.assign(size, 0);
+	mask = size - 1;
+
+	uint32_t old_generation = generation;
+	generation = 1;
+	count = 0;
+	for (uint i = 0; i < old_key.size(); i++)
+		if (old_stamp[i] == old_generation)
+			insert(old_key[i], old_value[i]);
+}
+
+SearchBuffer::SearchBuffer(int cell_num)
+	: dist(cell_num, -1), bfs_queue(cell_num), visited(1 << 12) {}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+// UP, RIGHT, DOWN, LEFT, WAIT
+const int DIR_ROW[5] = {-1, 0, 1, 0, 0};
+const int DIR_COL[5] = {0, 1, 0, -1, 0};
+
+// reservation keys -> vertex (time, cell) and edge (time, cell, direction) of a move at time -> time + 1
+#define VERTEX_KEY(t, cell)			((static_cast<uint64_t>(t) << 32) | static_cast<uint64_t>(cell))
+#define EDGE_KEY(t, cell, dir)		((1ULL << 63) | (static_cast<uint64_t>(t) << 32) | (static_cast<uint64_t>(cell) * 4 + (dir)))
+
+long long calcBatch(Map **, int, int, vector<Point> &, vector<Point> &, int, vector<AgentResult> &, long long &);
+bool passable(Map **, int, int, int);
+void goalDistance(Map **, int, int, int, int, SearchBuffer &);
+int searchAgent(Map **, int, int, int, int, int, HashTable &, const vector<int> &, const vector<int> &,
+		SearchBuffer &, AgentResult &, long long &);
+
+// usage: ./CAS [slack] -> every 3 cell is an agent, agent i goes to i-th 4 cell in row-major order
+// agents are planned in the same order, earlier agents have higher priority
+// slack -> max arrival time over the shortest length of an agent (row + col by default)
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// max waits and detours of an agent
+	int slack = -1;
+	if (argc > 1) {
+		slack = atoi(argv[1]);
+		if (slack < 0) {
+			cerr << "slack value error" << endl;
+			return -1;
+		}
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	vector<Point> start;
+	vector<Point> goal;
+	vector<AgentResult> result;
+	long long time = 0;
+	long long conflict = 0;
+	double seconds = 0.0;
+	chrono::steady_clock::time_point begin;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point can exist one or more
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				start.emplace_back(row_i, col_j);
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num >= 1
+	// goal num >= 1
+	if (start.size() == 0 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// every agent needs its own goal
+	if (goal.size() < start.size()) {
+		cerr << "input file needs a goal for every start" << endl;
+		goto RELEASE_DATA;
+	}
+
+	if (slack == -1)
+		slack = row + col;
+
+	// plan every agent in priority order
+	begin = chrono::steady_clock::now();
+	time = calcBatch(map_info, row, col, start, goal, slack, result, conflict);
+	seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+	// every result road
+	for (uint i = 0; i < result.size(); i++)
+		for (uint j = 0; j < result[i].road.size(); j++)
+			map_info[result[i].road[j] / col][result[i].road[j] % col] = Map::ROAD_G;
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// agent table -> start, goal, length, arrival time, waits, expanded states, -1 length -> no result
+	for (uint i = 0; i < result.size(); i++) {
+		output_f << "(" << start[i].row << "," << start[i].col << ")->";
+		output_f << "(" << goal[i].row << "," << goal[i].col << ") ";
+		output_f << "length=" << result[i].length << " ";
+		output_f << "arrival=" << result[i].arrival << " ";
+		output_f << "waits=" << result[i].waits << " ";
+		output_f << "time=" << result[i].time << endl;
+	}
+
+	output_f << "time=" << time << endl;
+	output_f << "agents=" << result.size() << endl;
+	output_f << "conflicts=" << conflict << endl;
+	output_f << "conflicts/sec=" << static_cast<long long>(conflict / (seconds > 0.0 ? seconds : 1e-9)) << endl;
+	output_f << "ms=" << seconds * 1000.0 << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// plan agents one by one with space-time A*, road of every planned agent is reserved for the next agents
+// an agent stays on its goal after arrival -> goal cell is parked from arrival time
+// return number of expanded states, conflict -> number of successors blocked by the reservation table
+long long calcBatch(Map **map, int row, int col, vector<Point> &start, vector<Point> &goal, int slack,
+		vector<AgentResult> &result, long long &conflict) {
+	long long time = 0;
+	int cell_num = row * col;
+
+	HashTable reservation(1 << 12);
+	vector<int> park_time(cell_num, INT_MAX);
+	vector<int> last_reserve(cell_num, -1);
+	SearchBuffer buffer(cell_num);
+
+	result.assign(start.size(), AgentResult());
+	for (uint i = 0; i < start.size(); i++) {
+		int start_idx = start[i].row * col + start[i].col;
+		int goal_idx = goal[i].row * col + goal[i].col;
+
+		int goal_node = searchAgent(map, row, col, start_idx, goal_idx, slack, reservation, park_time, last_reserve,
+				buffer, result[i], conflict);
+		time += result[i].time;
+
+		// no result -> agent stays on its start cell which nobody can enter
+		if (goal_node == -1)
+			continue;
+
+		// reserve every (time, cell) and move of road, then park on goal
+		for (int n = goal_node; n != -1; n = buffer.node[n].parent) {
+			const StateNode &cur = buffer.node[n];
+			reservation.insert(VERTEX_KEY(cur.t, cur.cell), i);
+			last_reserve[cur.cell] = max(last_reserve[cur.cell], cur.t);
+
+			if (cur.parent == -1)
+				continue;
+
+			const StateNode &prev = buffer.node[cur.parent];
+			for (int d = 0; d < 4; d++)
+				if (prev.cell / col + DIR_ROW[d] == cur.cell / col && prev.cell % col + DIR_COL[d] == cur.cell % col)
+					reservation.insert(EDGE_KEY(prev.t, prev.cell, d), i);
+		}
+
+		park_time[goal_idx] = result[i].arrival;
+	}
+
+	return time;
+}
+
+// agent can stand on ROAD, GOAL (goals of other agents too) and its own start cell
+bool passable(Map **map, int col, int start_idx, int cell) {
+	Map m = map[cell / col][cell % col];
+	return (m == Map::ROAD || m == Map::GOAL || cell == start_idx);
+}
+
+// breadth-first search from goal -> exact length to goal of every cell without other agents
+void goalDistance(Map **map, int row, int col, int start_idx, int goal_idx, SearchBuffer &buffer) {
+	int *dist = buffer.dist.data();
+	int *bfs_queue = buffer.bfs_queue.data();
+	int queue_head = 0;
+	int queue_tail = 0;
+
+	fill(buffer.dist.begin(), buffer.dist.end(), -1);
+	dist[goal_idx] = 0;
+	bfs_queue[queue_tail++] = goal_idx;
+
+	while (queue_head < queue_tail) {
+		int cur_idx = bfs_queue[queue_head++];
+		int cur_row = cur_idx / col;
+		int cur_col = cur_idx % col;
+
+		for (int d = 0; d < 4; d++) {
+			int next_row = cur_row + DIR_ROW[d];
+			int next_col = cur_col + DIR_COL[d];
+			if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+				continue;
+
+			int n = next_row * col + next_col;
+			if (dist[n] != -1 || !passable(map, col, start_idx, n))
+				continue;
+
+			dist[n] = dist[cur_idx] + 1;
+			bfs_queue[queue_tail++] = n;
+		}
+	}
+}
+
+// space-time A* over (cell, time) from start to goal, every move and wait costs 1
+// length from start of a state is its time -> first generated state is final, no decrease-key
+// return node index of goal state in buffer.node, -1 when there is no result
+int searchAgent(Map **map, int row, int col, int start_idx, int goal_idx, int slack, HashTable &reservation,
+		const vector<int> &park_time, const vector<int> &last_reserve, SearchBuffer &buffer, AgentResult &res,
+		long long &conflict) {
+	goalDistance(map, row, col, start_idx, goal_idx, buffer);
+	if (buffer.dist[start_idx] == -1)
+		return -1;
+
+	int horizon = buffer.dist[start_idx] + slack;
+
+	const int *dist = buffer.dist.data();
+	vector<StateNode> &node = buffer.node;
+	HashTable &visited = buffer.visited;
+	node.clear();
+	visited.clear();
+
+	// search smallest time + length to goal first
+	priority_queue<OpenNode, vector<OpenNode>, greater<OpenNode> > search_queue;
+	node.emplace_back(start_idx, 0, -1);
+	visited.insert(VERTEX_KEY(0, start_idx), 0);
+	search_queue.push(OpenNode(dist[start_idx], dist[start_idx], 0));
+
+	int goal_node = -1;
+	while (!search_queue.empty()) {
+		int cur_node = search_queue.top().cell;
+		search_queue.pop();
+
+		res.time++;
+
+		// goal can be parked only after every reservation on it
+		int cur_idx = node[cur_node].cell;
+		int cur_t = node[cur_node].t;
+		if (cur_idx == goal_idx && cur_t > last_reserve[goal_idx]) {
+			goal_node = cur_node;
+			break;
+		}
+
+		if (cur_t >= horizon)
+			continue;
+
+		int cur_row = cur_idx / col;
+		int cur_col = cur_idx % col;
+		int next_t = cur_t + 1;
+		for (int d = 0; d < 5; d++) {
+			int next_row = cur_row + DIR_ROW[d];
+			int next_col = cur_col + DIR_COL[d];
+			if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+				continue;
+
+			int n = next_row * col + next_col;
+			if (dist[n] == -1)
+				continue;
+
+			// vertex conflict, swap conflict or parked agent
+			if (reservation.find(VERTEX_KEY(next_t, n)) != NULL || next_t >= park_time[n] ||
+					(d < 4 && reservation.find(EDGE_KEY(cur_t, n, (d + 2) % 4)) != NULL)) {
+				conflict++;
+				continue;
+			}
+
+			uint64_t k = VERTEX_KEY(next_t, n);
+			if (visited.find(k) != NULL)
+				continue;
+
+			int next_node = static_cast<int>(node.size());
+			node.emplace_back(n, next_t, cur_node);
+			visited.insert(k, next_node);
+			search_queue.push(OpenNode(next_t + dist[n], dist[n], next_node));
+		}
+	}
+
+	if (goal_node == -1)
+		return -1;
+
+	res.arrival = node[goal_node].t;
+	res.length = res.arrival - 1;
+
+	// make result road to start point from goal, wait -> same cell as parent state
+	for (int n = goal_node; node[n].parent != -1; n = node[n].parent) {
+		int prev = node[n].parent;
+		if (node[n].cell == node[prev].cell)
+			res.waits++;
+		if (node[prev].cell != start_idx)
+			res.road.push_back(node[prev].cell);
+	}
+
+	return goal_node;
+}
@@ -0,0 +1,616 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell index
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+} OpenNode;
+
+// open list -> indexed 4-ary min heap of open nodes
+// pos keeps heap position of every cell (-1 -> not in heap) for decrease-key
+typedef struct OpenHeap {
+	OpenHeap(int);
+	bool empty() const;
+	int size() const;
+	bool contains(int) const;
+	const OpenNode &top() const;
+	const OpenNode &at(int) const;
+	void push(const OpenNode &);
+	void pop();
+	void decreaseKey(int, int);
+	void siftUp(int);
+	void siftDown(int);
+
+	vector<OpenNode> heap;
+	vector<int> pos;
+} OpenHeap;
+
+// result info -> length, time
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+} Result;
+
+// corridor compressed graph -> junctions, dead-ends, start and goals are nodes
+// edges in CSR order, each edge keeps first direction to walk the corridor again
+typedef struct Graph {
+	vector<int> node_id;
+	vector<int> node_cell;
+	vector<int> edge_offset;
+	vector<int> edge_to;
+	vector<int> edge_cost;
+	vector<uint8_t> edge_dir;
+} Graph;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+// heap size is bounded by cell_num
+OpenHeap::OpenHeap(int cell_num)
+	: pos(cell_num, -1) {}
+
+bool OpenHeap::empty() const {
+	return heap.empty();
+}
+
+int OpenHeap::size() const {
+	return static_cast<int>(heap.size());
+}
+
+bool OpenHeap::contains(int cell) const {
+	return pos[cell] != -1;
+}
+
+const OpenNode &OpenHeap::top() const {
+	return heap[0];
+}
+
+const OpenNode &OpenHeap::at(int cell) const {
+	return heap[pos[cell]];
+}
+
+void OpenHeap::push(const OpenNode &node) {
+	heap.push_back(node);
+	siftUp(size() - 1);
+}
+
+void OpenHeap::pop() {
+	pos[heap[0].cell] = -1;
+
+	OpenNode last = heap.back();
+	heap.pop_back();
+	if (!heap.empty()) {
+		heap[0] = last;
+		siftDown(0);
+	}
+}
+
+// set smaller score of cell in heap
+void OpenHeap::decreaseKey(int cell, int score) {
+	int i = pos[cell];
+	heap[i].score = score;
+	siftUp(i);
+}
+
+void OpenHeap::siftUp(int i) {
+	OpenNode node = heap[i];
+
+	while (i > 0) {
+		int parent = (i - 1) / 4;
+		if (!(heap[parent] > node))
+			break;
+
+		heap[i] = heap[parent];
+		pos[heap[i].cell] = i;
+		i = parent;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+void OpenHeap::siftDown(int i) {
+	OpenNode node = heap[i];
+	int n = size();
+
+	while (true) {
+		int first_child = 4 * i + 1;
+		if (first_child >= n)
+			break;
+
+		// smallest of up to 4 children
+		int best = first_child;
+		int last_child = min(first_child + 4, n);
+		for (int c = first_child + 1; c < last_child; c++)
+			if (heap[best] > heap[c])
+				best = c;
+
+		if (!(node > heap[best]))
+			break;
+
+		heap[i] = heap[best];
+		pos[heap[i].cell] = i;
+		i = best;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+Result::Result()
+	: length(0), time(0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+
+	return *this;
+}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+// UP, RIGHT, DOWN, LEFT
+const int DIR_ROW[4] = {-1, 0, 1, 0};
+const int DIR_COL[4] = {0, 1, 0, -1};
+
+Result calc(Map **, int, int, Point &, vector<Point> &);
+void buildGraph(Map **, int, int, Graph &);
+int walkCorridor(Map **, int, int, int, int, int *);
+int shortestLength(int, int, vector<Point> &);
+
+int NODE_NUM = 0;
+int EDGE_NUM = 0;
+double PREPROCESS_MS = 0.0;
+
+int main () {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	Point start;
+	vector<Point> goal;
+	Result result;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// calc best result
+	result = calc(map_info, row, col, start, goal);
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// best result
+	if (result.length != -1) {
+		output_f << "length=" << result.length << endl;
+		output_f << "time=" << result.time << endl;
+	}
+	// no result
+	else {
+		output_f << "time=" << result.time << endl;
+		output_f << "no result" << endl;
+	}
+
+	output_f << "nodes=" << NODE_NUM << endl;
+	output_f << "edges=" << EDGE_NUM << endl;
+	output_f << "preprocess_ms=" << PREPROCESS_MS << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// calc result road over corridor compressed graph
+// time -> number of expanded graph nodes
+Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal) {
+	Result res;
+
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	Graph graph;
+	buildGraph(map, row, col, graph);
+	PREPROCESS_MS = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+	int node_num = static_cast<int>(graph.node_cell.size());
+	NODE_NUM = node_num;
+	EDGE_NUM = static_cast<int>(graph.edge_to.size());
+
+	// per-node length from start, parent edge and closed flag
+	vector<int> length_from_start(node_num, 0);
+	vector<int> parent_edge(node_num, -1);
+	vector<int> parent(node_num, -1);
+	vector<uint8_t> closed(node_num, 0);
+
+	int start_node = graph.node_id[start.row * col + start.col];
+	parent[start_node] = start_node;
+
+	// search biggest score point first
+	OpenHeap search_queue(node_num);
+	search_queue.push(OpenNode(0, 0, start_node));
+	int goal_node = -1;
+
+	// search continuously until finding result
+	// search_queue is empty when there is no result
+	while (!search_queue.empty()) {
+		int cur = search_queue.top().cell;
+		search_queue.pop();
+
+		res.time++;
+
+		// check if goal node
+		int cur_cell = graph.node_cell[cur];
+		if (map[cur_cell / col][cur_cell % col] == Map::GOAL) {
+			goal_node = cur;
+			break;
+		}
+
+		closed[cur] = 1;
+
+		for (int e = graph.edge_offset[cur]; e < graph.edge_offset[cur + 1]; e++) {
+			int n = graph.edge_to[e];
+			if (closed[n])
+				continue;
+
+			int next_length = length_from_start[cur] + graph.edge_cost[e];
+			if (!search_queue.contains(n)) {
+				int length_to_goal = shortestLength(graph.node_cell[n] / col, graph.node_cell[n] % col, goal);
+				length_from_start[n] = next_length;
+				parent[n] = cur;
+				parent_edge[n] = e;
+				search_queue.push(OpenNode(next_length + length_to_goal, length_to_goal, n));
+			}
+			else if (next_length < length_from_start[n]) {
+				length_from_start[n] = next_length;
+				parent[n] = cur;
+				parent_edge[n] = e;
+				search_queue.decreaseKey(n, next_length + search_queue.at(n).length_to_goal);
+			}
+		}
+	}
+
+	// make result road to start point from goal
+	// walk every corridor edge again from its parent node
+	if (goal_node != -1) {
+		res.length = length_from_start[goal_node] - 1;
+
+		int track_node = goal_node;
+		while (track_node != start_node) {
+			int e = parent_edge[track_node];
+			int cur_cell = graph.node_cell[parent[track_node]];
+			int dir = graph.edge_dir[e];
+
+			// junction node on the road
+			if (parent[track_node] != start_node)
+				map[cur_cell / col][cur_cell % col] = Map::ROAD_G;
+
+			for (int step = 0; step < graph.edge_cost[e] - 1; step++) {
+				int prev_cell = cur_cell;
+				cur_cell += DIR_ROW[dir] * col + DIR_COL[dir];
+				map[cur_cell / col][cur_cell % col] = Map::ROAD_G;
+
+				// corridor cell has exactly one way except the way back
+				for (int d = 0; d < 4; d++) {
+					int next_row = cur_cell / col + DIR_ROW[d];
+					int next_col = cur_cell % col + DIR_COL[d];
+					if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+						continue;
+
+					int next_cell = next_row * col + next_col;
+					if (next_cell != prev_cell && map[next_row][next_col] != Map::WALL) {
+						dir = d;
+						break;
+					}
+				}
+			}
+
+			track_node = parent[track_node];
+		}
+	}
+	// no result
+	else
+		res.length = -1;
+
+	return res;
+}
+
+// collapse chains of degree-2 ROAD cells into weighted edges
+// node -> START, GOAL or ROAD cell whose number of non-WALL neighbours is not 2
+void buildGraph(Map **map, int row, int col, Graph &graph) {
+	graph.node_id.assign(row * col, -1);
+
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			Map cell = map[i][j];
+			if (cell == Map::WALL)
+				continue;
+
+			int degree = 0;
+			for (int d = 0; d < 4; d++) {
+				int next_row = i + DIR_ROW[d];
+				int next_col = j + DIR_COL[d];
+				if (next_row >= 0 && next_row < row && next_col >= 0 && next_col < col &&
+						map[next_row][next_col] != Map::WALL)
+					degree++;
+			}
+
+			if (cell != Map::ROAD || degree != 2) {
+				graph.node_id[i * col + j] = static_cast<int>(graph.node_cell.size());
+				graph.node_cell.push_back(i * col + j);
+			}
+		}
+	}
+
+	// edges of every node -> GOAL is the end of a road, START cannot be entered
+	int node_num = static_cast<int>(graph.node_cell.size());
+	graph.edge_offset.assign(node_num + 1, 0);
+	for (int u = 0; u < node_num; u++) {
+		graph.edge_offset[u] = static_cast<int>(graph.edge_to.size());
+
+		int cell = graph.node_cell[u];
+		if (map[cell / col][cell % col] == Map::GOAL)
+			continue;
+
+		for (int d = 0; d < 4; d++) {
+			int end_cell = cell;
+			int cost = walkCorridor(map, row, col, cell, d, &end_cell);
+			if (cost == 0 || end_cell == cell || map[end_cell / col][end_cell % col] == Map::START)
+				continue;
+
+			graph.edge_to.push_back(graph.node_id[end_cell]);
+			graph.edge_cost.push_back(cost);
+			graph.edge_dir.push_back(static_cast<uint8_t>(d));
+		}
+	}
+	graph.edge_offset[node_num] = static_cast<int>(graph.edge_to.size());
+}
+
+// walk from node cell to direction until next node cell
+// return number of moves, 0 when the direction is blocked
+int walkCorridor(Map **map, int row, int col, int cell, int dir, int *end_cell) {
+	int prev_cell = -1;
+	int cost = 0;
+
+	while (true) {
+		int next_row = cell / col + DIR_ROW[dir];
+		int next_col = cell % col + DIR_COL[dir];
+		if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col ||
+				map[next_row][next_col] == Map::WALL)
+			return 0;
+
+		prev_cell = cell;
+		cell = next_row * col + next_col;
+		cost++;
+
+		// next node is found
+		if (map[next_row][next_col] != Map::ROAD)
+			break;
+
+		// corridor cell has exactly one way except the way back
+		int d = 0;
+		for (; d < 4; d++) {
+			int corridor_row = next_row + DIR_ROW[d];
+			int corridor_col = next_col + DIR_COL[d];
+			if (corridor_row < 0 || corridor_row >= row || corridor_col < 0 || corridor_col >= col)
+				continue;
+
+			if (corridor_row * col + corridor_col != prev_cell && map[corridor_row][corridor_col] != Map::WALL)
+				break;
+		}
+
+		// junction or dead-end -> next node is found
+		int degree = 0;
+		for (int k = 0; k < 4; k++) {
+			int corridor_row = next_row + DIR_ROW[k];
+			int corridor_col = next_col + DIR_COL[k];
+			if (corridor_row >= 0 && corridor_row < row && corridor_col >= 0 && corridor_col < col &&
+					map[corridor_row][corridor_col] != Map::WALL)
+				degree++;
+		}
+
+		if (degree != 2)
+			break;
+
+		dir = d;
+	}
+
+	*end_cell = cell;
+	return cost;
+}
+
+// calc shortest length to several goals
+int shortestLength(int row, int col, vector<Point> &goal) {
+	int length = INT_MAX;
+
+	Point cur_p(row, col);
+	for (uint i = 0; i < goal.size(); i++) {
+		int curLength = DISTANCE(cur_p, goal[i]);
+
+		if (length > curLength)
+			length = curLength;
+	}
+
+	return length;
+}
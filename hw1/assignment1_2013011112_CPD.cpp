@@ -0,0 +1,613 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// result info -> length, time (first move lookups), elapsed us
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+	double query_us;
+} Result;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// database file header, followed by
+//   int32 node_of_cell[row * col]  -> node index of every cell, -1 for WALL
+//   int32 component[node_num]      -> connected component of every node
+//   (padding to 8 bytes)
+//   uint64 run_offset[node_num + 1] -> first run of every source node
+//   uint32 run[run_num]            -> (first target node << 2) | first move, targets in node order
+typedef struct CpdHeader {
+	char magic[4];
+	int32_t row;
+	int32_t col;
+	int32_t node_num;
+	uint64_t version;
+	uint64_t run_num;
+} CpdHeader;
+
+// build stats -> sources, runs, file bytes, elapsed ms
+typedef struct BuildResult {
+	BuildResult();
+
+	int node_num;
+	uint64_t run_num;
+	uint64_t bytes;
+	double build_ms;
+} BuildResult;
+
+// read-only view of mapped database file
+typedef struct CpdView {
+	CpdView();
+	bool open(const string &);
+	void close();
+	int firstMove(int, int) const;
+
+	void *data;
+	size_t size;
+	const CpdHeader *header;
+	const int32_t *node_of_cell;
+	const int32_t *component;
+	const uint64_t *run_offset;
+	const uint32_t *run;
+} CpdView;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+Result::Result()
+	: length(0), time(0), query_us(0.0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_), query_us(0.0) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+	query_us = res.query_us;
+
+	return *this;
+}
+
+BuildResult::BuildResult()
+	: node_num(0), run_num(0), bytes(0), build_ms(0.0) {}
+
+CpdView::CpdView()
+	: data(MAP_FAILED), size(0), header(NULL), node_of_cell(NULL), component(NULL), run_offset(NULL), run(NULL) {}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+// UP, RIGHT, DOWN, LEFT -> same order as findPossibleMoves flags
+const int DIR_ROW[4] = {-1, 0, 1, 0};
+const int DIR_COL[4] = {0, 1, 0, -1};
+
+uint64_t mapVersion(Map **, int, int);
+uint64_t cellHash(uint64_t);
+size_t runOffsetPosition(int, int);
+bool buildDatabase(Map **, int, int, const string &, int, BuildResult &);
+Result calc(Map **, int, Point &, vector<Point> &, const CpdView &);
+
+// usage: ./CPD build [db_file] [threads] -> first move database of input.txt map (cpd.bin, hardware threads)
+//        ./CPD [db_file]                 -> road from 3 cell to the nearest 4 cell with the database, no search
+// database only depends on WALL cells, starts and goals can change between build and query
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// mode, database file and number of build threads
+	bool build = (argc > 1 && strcmp(argv[1], "build") == 0);
+	int arg_i = build ? 2 : 1;
+	string db_filename = (argc > arg_i) ? argv[arg_i] : "cpd.bin";
+	int thread_num = static_cast<int>(thread::hardware_concurrency());
+	if (build && argc > 3)
+		thread_num = atoi(argv[3]);
+	if (thread_num <= 0)
+		thread_num = 1;
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	Point start;
+	vector<Point> goal;
+	Result result;
+	BuildResult build_result;
+	CpdView view;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// build database and write its stats
+	if (build) {
+		if (!buildDatabase(map_info, row, col, db_filename, thread_num, build_result)) {
+			cerr << "database file cannot be written" << endl;
+			goto RELEASE_DATA;
+		}
+
+		// write
+		for (int i = 0; i < row; i++) {
+			for (int j = 0; j < col; j++) {
+				output_f << static_cast<int>(map_info[i][j]) << " ";
+			}
+
+			output_f << endl;
+		}
+
+		output_f << "---" << endl;
+		output_f << "sources=" << build_result.node_num << endl;
+		output_f << "runs=" << build_result.run_num << endl;
+		output_f << "bytes=" << build_result.bytes << endl;
+		output_f << "threads=" << thread_num << endl;
+		output_f << "build_ms=" << build_result.build_ms << endl;
+
+		goto RELEASE_DATA;
+	}
+
+	// map database file and check that it was built from this map
+	if (!view.open(db_filename)) {
+		cerr << "database file cannot be opened" << endl;
+		goto RELEASE_DATA;
+	}
+
+	if (view.header->row != row || view.header->col != col || view.header->version != mapVersion(map_info, row, col)) {
+		cerr << "database file is built from another map" << endl;
+		view.close();
+		goto RELEASE_DATA;
+	}
+
+	// calc best result
+	result = calc(map_info, col, start, goal, view);
+	view.close();
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// best result
+	if (result.length != -1) {
+		output_f << "length=" << result.length << endl;
+		output_f << "time=" << result.time << endl;
+	}
+	// no result
+	else {
+		output_f << "time=" << result.time << endl;
+		output_f << "no result" << endl;
+	}
+	output_f << "query_us=" << result.query_us << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// version of WALL cells -> xor of every cell hash
+uint64_t mapVersion(Map **map, int row, int col) {
+	uint64_t version = cellHash((static_cast<uint64_t>(row) << 32) | static_cast<uint64_t>(col));
+	for (int i = 0; i < row; i++)
+		for (int j = 0; j < col; j++)
+			version ^= cellHash((static_cast<uint64_t>(i * col + j) << 1) | (map[i][j] == Map::WALL));
+
+	return version;
+}
+
+// mix 64-bit value (splitmix64 finalizer)
+uint64_t cellHash(uint64_t k) {
+	k += 0x9E3779B97F4A7C15ULL;
+	k = (k ^ (k >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	k = (k ^ (k >> 27)) * 0x94D049BB133111EBULL;
+
+	return k ^ (k >> 31);
+}
+
+// file position of run_offset array -> after header, node_of_cell, component and padding
+size_t runOffsetPosition(int cell_num, int node_num) {
+	size_t position = sizeof(CpdHeader) + sizeof(int32_t) * (static_cast<size_t>(cell_num) + node_num);
+
+	return (position + 7) & ~static_cast<size_t>(7);
+}
+
+// one breadth-first search per source node, sources are shared between threads
+// first move toward every target is inherited from the first step of its road
+// row of every source is run-length encoded, target itself and unreachable targets
+// continue the current run
+bool buildDatabase(Map **map, int row, int col, const string &db_filename, int thread_num, BuildResult &res) {
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	int cell_num = row * col;
+
+	// node -> every cell except WALL
+	vector<int32_t> node_of_cell(cell_num, -1);
+	vector<int> cell_of_node;
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			if (map[i][j] == Map::WALL)
+				continue;
+
+			node_of_cell[i * col + j] = static_cast<int32_t>(cell_of_node.size());
+			cell_of_node.push_back(i * col + j);
+		}
+	}
+
+	int node_num = static_cast<int>(cell_of_node.size());
+	vector<int32_t> component(node_num, -1);
+	vector<vector<uint32_t> > run(node_num);
+
+	if (thread_num > node_num)
+		thread_num = max(node_num, 1);
+
+	atomic<int> next_source(0);
+	vector<thread> workers;
+	for (int t = 0; t < thread_num; t++) {
+		workers.emplace_back([&]() {
+			vector<int8_t> first_move(node_num, -1);
+			vector<int> search_queue(node_num);
+
+			int s;
+			while ((s = next_source.fetch_add(1)) < node_num) {
+				int queue_head = 0;
+				int queue_tail = 0;
+
+				fill(first_move.begin(), first_move.end(), -1);
+				first_move[s] = 4;
+				search_queue[queue_tail++] = s;
+
+				while (queue_head < queue_tail) {
+					int cur = search_queue[queue_head++];
+					int cur_row = cell_of_node[cur] / col;
+					int cur_col = cell_of_node[cur] % col;
+
+					for (int d = 0; d < 4; d++) {
+						int next_row = cur_row + DIR_ROW[d];
+						int next_col = cur_col + DIR_COL[d];
+						if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+							continue;
+
+						int n = node_of_cell[next_row * col + next_col];
+						if (n == -1 || first_move[n] != -1)
+							continue;
+
+						first_move[n] = (cur == s) ? d : first_move[cur];
+						search_queue[queue_tail++] = n;
+					}
+				}
+
+				// component -> smallest node reached, the same for every node of the component
+				component[s] = search_queue[0];
+				for (int i = 1; i < queue_tail; i++)
+					component[s] = min(component[s], search_queue[i]);
+
+				// run-length encoding of first moves
+				vector<uint32_t> &row_run = run[s];
+				int cur_move = -1;
+				for (int n = 0; n < node_num; n++) {
+					int move = first_move[n];
+					if (move < 0 || move > 3 || move == cur_move)
+						continue;
+
+					// first run starts at target 0
+					uint32_t first_target = row_run.empty() ? 0 : static_cast<uint32_t>(n);
+					row_run.push_back((first_target << 2) | static_cast<uint32_t>(move));
+					cur_move = move;
+				}
+
+				// no reachable target -> one dummy run
+				if (row_run.empty())
+					row_run.push_back(0);
+			}
+		});
+	}
+
+	for (uint t = 0; t < workers.size(); t++)
+		workers[t].join();
+
+	// write header and arrays in file order
+	vector<uint64_t> run_offset(node_num + 1, 0);
+	for (int s = 0; s < node_num; s++)
+		run_offset[s + 1] = run_offset[s] + run[s].size();
+
+	CpdHeader header;
+	memcpy(header.magic, "CPD1", 4);
+	header.row = row;
+	header.col = col;
+	header.node_num = node_num;
+	header.version = mapVersion(map, row, col);
+	header.run_num = run_offset[node_num];
+
+	ofstream db_f(db_filename, ios::binary);
+	if (!db_f.is_open())
+		return false;
+
+	size_t position = sizeof(CpdHeader) + sizeof(int32_t) * (static_cast<size_t>(cell_num) + node_num);
+	const char padding[8] = {0};
+
+	db_f.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	db_f.write(reinterpret_cast<const char *>(node_of_cell.data()), sizeof(int32_t) * cell_num);
+	db_f.write(reinterpret_cast<const char *>(component.data()), sizeof(int32_t) * node_num);
+	db_f.write(padding, runOffsetPosition(cell_num, node_num) - position);
+	db_f.write(reinterpret_cast<const char *>(run_offset.data()), sizeof(uint64_t) * (node_num + 1));
+	for (int s = 0; s < node_num; s++)
+		db_f.write(reinterpret_cast<const char *>(run[s].data()), sizeof(uint32_t) * run[s].size());
+
+	if (!db_f.good())
+		return false;
+
+	res.node_num = node_num;
+	res.run_num = header.run_num;
+	res.bytes = static_cast<uint64_t>(db_f.tellp());
+	res.build_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+	db_f.close();
+
+	return true;
+}
+
+// map database file read-only and set array pointers
+bool CpdView::open(const string &db_filename) {
+	int fd = ::open(db_filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(CpdHeader)) {
+		::close(fd);
+		return false;
+	}
+
+	size = static_cast<size_t>(st.st_size);
+	data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+		return false;
+
+	const char *base = static_cast<const char *>(data);
+	header = reinterpret_cast<const CpdHeader *>(base);
+
+	int cell_num = header->row * header->col;
+	size_t position = runOffsetPosition(cell_num, header->node_num);
+	if (memcmp(header->magic, "CPD1", 4) != 0 ||
+			size != position + sizeof(uint64_t) * (header->node_num + 1) + sizeof(uint32_t) * header->run_num) {
+		close();
+		return false;
+	}
+
+	node_of_cell = reinterpret_cast<const int32_t *>(base + sizeof(CpdHeader));
+	component = node_of_cell + cell_num;
+	run_offset = reinterpret_cast<const uint64_t *>(base + position);
+	run = reinterpret_cast<const uint32_t *>(run_offset + header->node_num + 1);
+
+	return true;
+}
+
+void CpdView::close() {
+	if (data != MAP_FAILED)
+		munmap(data, size);
+
+	data = MAP_FAILED;
+}
+
+// first move from source node toward target node -> binary search of the source row
+int CpdView::firstMove(int source, int target) const {
+	const uint32_t *first = run + run_offset[source];
+	const uint32_t *last = run + run_offset[source + 1];
+
+	// last run whose first target is not after target
+	const uint32_t *it = upper_bound(first, last, (static_cast<uint32_t>(target) << 2) | 3) - 1;
+
+	return static_cast<int>(*it & 3);
+}
+
+// calc result road by walking first moves toward every goal, keep the shortest one
+// time -> number of first move lookups
+Result calc(Map **map, int col, Point &start, vector<Point> &goal, const CpdView &view) {
+	Result res;
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+
+	int start_node = view.node_of_cell[start.row * col + start.col];
+	int best_goal = -1;
+	int best_moves = INT_MAX;
+
+	for (uint i = 0; i < goal.size(); i++) {
+		int goal_node = view.node_of_cell[goal[i].row * col + goal[i].col];
+		if (view.component[start_node] != view.component[goal_node])
+			continue;
+
+		// walk until goal or until the road is not shorter than the best one
+		int cur_row = start.row;
+		int cur_col = start.col;
+		int cur_node = start_node;
+		int moves = 0;
+		while (cur_node != goal_node && moves < best_moves) {
+			int d = view.firstMove(cur_node, goal_node);
+			cur_row += DIR_ROW[d];
+			cur_col += DIR_COL[d];
+			cur_node = view.node_of_cell[cur_row * col + cur_col];
+			moves++;
+			res.time++;
+		}
+
+		if (cur_node == goal_node && moves < best_moves) {
+			best_moves = moves;
+			best_goal = i;
+		}
+	}
+
+	// make result road by walking again toward the best goal
+	if (best_goal != -1) {
+		int goal_node = view.node_of_cell[goal[best_goal].row * col + goal[best_goal].col];
+		int cur_row = start.row;
+		int cur_col = start.col;
+		int cur_node = start_node;
+
+		res.length = best_moves - 1;
+		for (int m = 0; m < best_moves - 1; m++) {
+			int d = view.firstMove(cur_node, goal_node);
+			cur_row += DIR_ROW[d];
+			cur_col += DIR_COL[d];
+			cur_node = view.node_of_cell[cur_row * col + cur_col];
+			map[cur_row][cur_col] = Map::ROAD_G;
+		}
+	}
+	// no result
+	else
+		res.length = -1;
+
+	res.query_us = chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count();
+
+	return res;
+}
@@ -0,0 +1,546 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// matrix result info -> N x M lengths, expanded cells, elapsed seconds
+typedef struct MatrixResult {
+	MatrixResult();
+
+	vector<int32_t> length;
+	long long time;
+	double seconds;
+} MatrixResult;
+
+// per-thread search buffers -> reused for every source of the thread
+typedef struct SearchBuffer {
+	SearchBuffer(int);
+
+	vector<int> stamp;
+	vector<int> dist;
+	vector<int> search_queue;
+} SearchBuffer;
+
+// per-thread multi-source search buffers -> one bit per source of the batch in every mask
+// masks are (row + 2) x (col + 2) with a WALL border, WALL cells are seen by every source
+// level mask is zero except the cells in its frontier list
+typedef struct BatchBuffer {
+	BatchBuffer(const vector<uint8_t> &, int, int);
+
+	vector<uint64_t> wall_seen;
+	vector<uint64_t> seen;
+	vector<uint64_t> level[2];
+	vector<int> frontier[2];
+} BatchBuffer;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+MatrixResult::MatrixResult()
+	: time(0), seconds(0.0) {}
+
+SearchBuffer::SearchBuffer(int cell_num)
+	: stamp(cell_num, -1), dist(cell_num, 0), search_queue(cell_num) {}
+
+BatchBuffer::BatchBuffer(const vector<uint8_t> &walkable, int row, int col)
+	: wall_seen(static_cast<size_t>(row + 2) * (col + 2), ~0ULL) {
+	for (int i = 0; i < row; i++)
+		for (int j = 0; j < col; j++)
+			if (walkable[i * col + j])
+				wall_seen[(i + 1) * (col + 2) + j + 1] = 0;
+
+	seen.resize(wall_seen.size());
+	for (int b = 0; b < 2; b++) {
+		level[b].assign(wall_seen.size(), 0);
+		frontier[b].resize(wall_seen.size());
+	}
+}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+MatrixResult calcMatrix(Map **, int, int, vector<Point> &, vector<Point> &, int, bool);
+long long searchSource(const vector<uint8_t> &, int, int, int, const vector<int> &, int, SearchBuffer &, int32_t *);
+long long searchBatch(int, int, const vector<int> &, const int *, int, vector<Point> &, BatchBuffer &, int32_t *);
+
+// usage: ./DMX [threads] [bfs|msbfs] -> every 3 cell is a source, every 4 cell is a target
+// bfs -> one breadth-first search per source (default), msbfs -> 64 sources per bit-parallel search
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+	string matrix_filename = "output_matrix.bin";
+
+	// number of worker threads, hardware concurrency when omitted
+	int thread_num = static_cast<int>(thread::hardware_concurrency());
+	if (argc > 1)
+		thread_num = atoi(argv[1]);
+	if (thread_num <= 0)
+		thread_num = 1;
+
+	// search engine
+	bool multi_source = (argc > 2 && strcmp(argv[2], "msbfs") == 0);
+	if (argc > 2 && !multi_source && strcmp(argv[2], "bfs") != 0) {
+		cerr << "unknown engine " << argv[2] << endl;
+		return -1;
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	vector<Point> start;
+	vector<Point> goal;
+	MatrixResult result;
+	ofstream matrix_f;
+	int32_t header[2];
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point can exist one or more -> matrix row
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				start.emplace_back(row_i, col_j);
+				break;
+
+			// goal point can exist one or more -> matrix column
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num >= 1
+	// goal num >= 1
+	if (start.size() == 0 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// calc start x goal length matrix
+	result = calcMatrix(map_info, row, col, start, goal, thread_num, multi_source);
+
+	// write binary matrix -> int32 N, int32 M, N * M int32 lengths in row-major order
+	matrix_f.open(matrix_filename, ios::binary);
+	if (!matrix_f.is_open()) {
+		cerr << "matrix file cannot be opened" << endl;
+		goto RELEASE_DATA;
+	}
+
+	header[0] = static_cast<int32_t>(start.size());
+	header[1] = static_cast<int32_t>(goal.size());
+	matrix_f.write(reinterpret_cast<const char *>(header), sizeof(header));
+	matrix_f.write(reinterpret_cast<const char *>(result.length.data()), result.length.size() * sizeof(int32_t));
+	matrix_f.close();
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	output_f << "matrix=" << start.size() << "x" << goal.size() << endl;
+	// one line per start, -1 -> no result
+	for (uint i = 0; i < start.size(); i++) {
+		for (uint j = 0; j < goal.size(); j++)
+			output_f << result.length[i * goal.size() + j] << " ";
+
+		output_f << endl;
+	}
+
+	output_f << "time=" << result.time << endl;
+	output_f << "threads=" << thread_num << endl;
+	output_f << "engine=" << (multi_source ? "msbfs" : "bfs") << endl;
+	output_f << "cells/sec=" << static_cast<long long>(result.time / (result.seconds > 0.0 ? result.seconds : 1e-9)) << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// calc length matrix with one breadth-first search per start, or one search per 64 starts
+// starts (or batches of starts) are shared between threads, each thread reuses its own search buffer
+MatrixResult calcMatrix(Map **map, int row, int col, vector<Point> &start, vector<Point> &goal, int thread_num, bool multi_source) {
+	MatrixResult res;
+	int cell_num = row * col;
+	int start_num = static_cast<int>(start.size());
+	int goal_num = static_cast<int>(goal.size());
+
+	// flat walkable grid -> every cell except WALL
+	vector<uint8_t> walkable(cell_num);
+	for (int i = 0; i < row; i++)
+		for (int j = 0; j < col; j++)
+			walkable[i * col + j] = (map[i][j] != Map::WALL);
+
+	// matrix column of every goal cell, -1 for the other cells
+	vector<int> goal_col(cell_num, -1);
+	for (int i = 0; i < goal_num; i++)
+		goal_col[goal[i].row * col + goal[i].col] = i;
+
+	res.length.assign(static_cast<size_t>(start_num) * goal_num, -1);
+
+	vector<int> start_idx(start_num);
+	for (int s = 0; s < start_num; s++)
+		start_idx[s] = start[s].row * col + start[s].col;
+
+	// msbfs batch -> 64 starts of nearby 8 x 8 blocks, their levels overlap more than 64 starts of one row
+	vector<int> batch_order(start_num);
+	for (int s = 0; s < start_num; s++)
+		batch_order[s] = s;
+	sort(batch_order.begin(), batch_order.end(), [&](int a, int b) {
+		if (start[a].row / 8 != start[b].row / 8)
+			return start[a].row / 8 < start[b].row / 8;
+		if (start[a].col / 8 != start[b].col / 8)
+			return start[a].col / 8 < start[b].col / 8;
+
+		return a < b;
+	});
+
+	// unit of work -> one start, or 64 starts in msbfs
+	int batch_size = multi_source ? 64 : 1;
+	int batch_num = (start_num + batch_size - 1) / batch_size;
+	if (thread_num > batch_num)
+		thread_num = batch_num;
+
+	atomic<int> next_batch(0);
+	vector<long long> thread_time(thread_num, 0);
+	vector<thread> workers;
+
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+
+	for (int t = 0; t < thread_num; t++) {
+		workers.emplace_back([&, t]() {
+			if (multi_source) {
+				BatchBuffer buffer(walkable, row, col);
+
+				int b;
+				while ((b = next_batch.fetch_add(1)) < batch_num) {
+					int first = b * batch_size;
+					int source_num = min(batch_size, start_num - first);
+					thread_time[t] += searchBatch(row, col, start_idx, &batch_order[first], source_num, goal, buffer,
+							res.length.data());
+				}
+
+				return;
+			}
+
+			SearchBuffer buffer(cell_num);
+
+			int s;
+			while ((s = next_batch.fetch_add(1)) < start_num) {
+				thread_time[t] += searchSource(walkable, row, col, start_idx[s], goal_col, goal_num, buffer,
+						&res.length[static_cast<size_t>(s) * goal_num]);
+			}
+		});
+	}
+
+	for (uint t = 0; t < workers.size(); t++)
+		workers[t].join();
+
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	res.seconds = chrono::duration<double>(end - begin).count();
+
+	for (int t = 0; t < thread_num; t++)
+		res.time += thread_time[t];
+
+	return res;
+}
+
+// breadth-first search from one start until every goal is reached
+// fill length row of the matrix, return number of expanded cells
+long long searchSource(const vector<uint8_t> &walkable, int row, int col, int start_idx,
+		const vector<int> &goal_col, int goal_num, SearchBuffer &buffer, int32_t *length) {
+	long long time = 0;
+
+	// stamp marks visited cells of this search -> no clear between searches
+	int *stamp = buffer.stamp.data();
+	int *dist = buffer.dist.data();
+	int *search_queue = buffer.search_queue.data();
+	int queue_head = 0;
+	int queue_tail = 0;
+
+	stamp[start_idx] = start_idx;
+	dist[start_idx] = 0;
+	search_queue[queue_tail++] = start_idx;
+
+	// count goals not reached yet
+	int remain_goal = goal_num;
+
+	while (queue_head < queue_tail && remain_goal > 0) {
+		int cur_idx = search_queue[queue_head++];
+		int cur_row = cur_idx / col;
+		int cur_col = cur_idx % col;
+		int next_dist = dist[cur_idx] + 1;
+
+		time++;
+
+		// length -> number of cells between start and goal
+		if (goal_col[cur_idx] != -1) {
+			length[goal_col[cur_idx]] = dist[cur_idx] - 1;
+			remain_goal--;
+		}
+
+		// UP, RIGHT, DOWN, LEFT
+		int next_idx[4] = {-1, -1, -1, -1};
+		if (cur_row > 0)
+			next_idx[0] = cur_idx - col;
+		if (cur_col < col - 1)
+			next_idx[1] = cur_idx + 1;
+		if (cur_row < row - 1)
+			next_idx[2] = cur_idx + col;
+		if (cur_col > 0)
+			next_idx[3] = cur_idx - 1;
+
+		for (int d = 0; d < 4; d++) {
+			int n = next_idx[d];
+			if (n == -1 || !walkable[n] || stamp[n] == start_idx)
+				continue;
+
+			stamp[n] = start_idx;
+			dist[n] = next_dist;
+			search_queue[queue_tail++] = n;
+		}
+	}
+
+	return time;
+}
+
+// bit-parallel breadth-first search of up to 64 sources (MS-BFS)
+// bit k of a cell mask -> source k, one level step advances every source at once
+//   small frontier -> push masks of frontier cells to their 4 neighbours
+//   big frontier   -> sweep every cell in the rows of the frontier without branch,
+//                     next = (masks of 4 neighbours) & ~seen & active
+// a source leaves the search when all of its goals are reached
+// fill length rows of source_num starts in source, return number of expanded (cell, source) pairs
+long long searchBatch(int row, int col, const vector<int> &start_idx, const int *source, int source_num,
+		vector<Point> &goal, BatchBuffer &buffer, int32_t *length) {
+	long long time = 0;
+	int goal_num = static_cast<int>(goal.size());
+	int pad_col = col + 2;
+	int dir_offset[4] = {-pad_col, 1, pad_col, -1};
+
+	uint64_t *seen = buffer.seen.data();
+	memcpy(seen, buffer.wall_seen.data(), buffer.wall_seen.size() * sizeof(uint64_t));
+
+	// count goals not reached yet of every source, active -> sources still searching
+	int remain_goal[64];
+	uint64_t active = 0;
+
+	int cur = 0;
+	uint64_t *visit = buffer.level[cur].data();
+	int *cur_cell = buffer.frontier[cur].data();
+	int cur_num = 0;
+	for (int k = 0; k < source_num; k++) {
+		int p = (start_idx[source[k]] / col + 1) * pad_col + start_idx[source[k]] % col + 1;
+		if (visit[p] == 0)
+			cur_cell[cur_num++] = p;
+
+		seen[p] |= 1ULL << k;
+		visit[p] |= 1ULL << k;
+		remain_goal[k] = goal_num;
+		active |= 1ULL << k;
+	}
+
+	for (int level = 0; cur_num > 0; level++) {
+		// length -> number of cells between start and goal
+		for (int j = 0; j < goal_num; j++) {
+			uint64_t bits = visit[(goal[j].row + 1) * pad_col + goal[j].col + 1] & active;
+			for (; bits != 0; bits &= bits - 1) {
+				int k = __builtin_ctzll(bits);
+				length[static_cast<size_t>(source[k]) * goal_num + j] = level - 1;
+				if (--remain_goal[k] == 0)
+					active &= ~(1ULL << k);
+			}
+		}
+
+		if (active == 0)
+			break;
+
+		int next = 1 - cur;
+		uint64_t *visit_next = buffer.level[next].data();
+		int *next_cell = buffer.frontier[next].data();
+		int next_num = 0;
+
+		// rows of the frontier
+		int first_row = row;
+		int last_row = 1;
+		for (int i = 0; i < cur_num; i++) {
+			first_row = min(first_row, cur_cell[i] / pad_col);
+			last_row = max(last_row, cur_cell[i] / pad_col);
+		}
+
+		first_row = max(1, first_row - 1);
+		last_row = min(row, last_row + 1);
+
+		if (static_cast<long long>(last_row - first_row + 1) * col < static_cast<long long>(cur_num) * 16) {
+			for (int r = first_row; r <= last_row; r++) {
+				for (int p = r * pad_col + 1; p <= r * pad_col + col; p++) {
+					uint64_t bits = (visit[p - pad_col] | visit[p + pad_col] | visit[p - 1] | visit[p + 1]) & ~seen[p] & active;
+					visit_next[p] = bits;
+					seen[p] |= bits;
+					next_cell[next_num] = p;
+					next_num += (bits != 0);
+				}
+			}
+		}
+		else {
+			for (int i = 0; i < cur_num; i++) {
+				uint64_t cur_visit = visit[cur_cell[i]] & active;
+				for (int d = 0; d < 4; d++) {
+					int n = cur_cell[i] + dir_offset[d];
+					uint64_t bits = cur_visit & ~seen[n];
+					if (bits == 0)
+						continue;
+
+					if (visit_next[n] == 0)
+						next_cell[next_num++] = n;
+					visit_next[n] |= bits;
+				}
+			}
+
+			for (int i = 0; i < next_num; i++)
+				seen[next_cell[i]] |= visit_next[next_cell[i]];
+		}
+
+		// current level mask is zero again
+		for (int i = 0; i < cur_num; i++)
+			visit[cur_cell[i]] = 0;
+
+		cur = next;
+		visit = visit_next;
+		cur_cell = next_cell;
+		cur_num = next_num;
+	}
+
+	// expanded pairs -> every source of every seen cell, WALL cells are seen by all sources
+	for (uint p = 0; p < buffer.seen.size(); p++)
+		if (buffer.wall_seen[p] == 0)
+			time += __builtin_popcountll(seen[p]);
+
+	// clear level mask for the next batch
+	for (int i = 0; i < cur_num; i++)
+		visit[cur_cell[i]] = 0;
+
+	return time;
+}
@@ -3,11 +3,53 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <climits>
+#include <algorithm>
 #include <queue>
+#include <functional>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// per-phase timers and search counters -> build with -DPROFILE to enable
+#ifdef PROFILE
+#include <chrono>
+#endif
+
+// expansion trace recorder -> build with -DTRACE to enable
+// the last TRACE_CAPACITY expansions are kept in a ring buffer allocated before the search
+#ifdef TRACE
+#include <cstdint>
+#include <cstring>
+
+#ifndef TRACE_CAPACITY
+#define TRACE_CAPACITY (1 << 20)
+#endif
+#endif
+
+// move mode -> 4 direction (default) or 8 direction with -DMOVE_DIR=8
+#ifndef MOVE_DIR
+#define MOVE_DIR 4
+#endif
+
+// move cost -> 1 per move in 4 direction mode, 10/14 (straight/diagonal) in 8 direction mode
+#if MOVE_DIR == 8
+#define STRAIGHT_COST	10
+#define DIAGONAL_COST	14
+
+// calc octile distance
+#define DISTANCE(p1, p2)	(STRAIGHT_COST * max(abs(p1.row - p2.row), abs(p1.col - p2.col)) + \
+							 (DIAGONAL_COST - STRAIGHT_COST) * min(abs(p1.row - p2.row), abs(p1.col - p2.col)))
+#else
+#define STRAIGHT_COST	1
+#define DIAGONAL_COST	2
 
 // calc manhattan distance
 #define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
 							 abs(p1.col - p2.col))
+#endif
 
 using namespace std;
 
@@ -22,16 +64,15 @@ typedef struct Point {
 	int col;
 } Point;
 
-// node info -> point info, length to goal, child and parent node
-typedef struct Node {
-	Node(int, int, Node * = NULL, int = 0);
+// open list node -> length to goal, cell index
+// stored inline in the heap (8 bytes), parent is a per-cell array
+typedef struct OpenNode {
+	OpenNode(int, int);
+	bool operator>(const OpenNode &) const;
 
-	Point p;
 	int length;
-
-	vector<Node *> child;
-	Node *parent;
-} Node;
+	int cell;
+} OpenNode;
 
 // result info -> length, time
 typedef struct Result {
@@ -41,6 +82,7 @@ typedef struct Result {
 
 	int length;
 	int time;
+	int cost;
 } Result;
 
 // Map enum data
@@ -74,34 +116,27 @@ bool Point::operator!=(const Point &p) {
 	return (this->row != p.row || this->col != p.col);
 }
 
-Node::Node(int row_, int col_, Node *parent_, int length_) {
-	p.row = row_;
-	p.col = col_;
-	length = length_;
-
-	// for root node
-	if (parent_ == NULL)
-		parent = this;
-	else
-		parent = parent_;
-}
+OpenNode::OpenNode(int length_, int cell_)
+	: length(length_), cell(cell_) {}
 
 // compare score -> smaller length, bigger score
-struct Compare {
-	bool operator() (const Node *n1, const Node *n2) {
-		return n1->length > n2->length;
-	}
-};
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (length != n.length)
+		return length > n.length;
+
+	return cell > n.cell;
+}
 
 Result::Result()
-	: length(0), time(0) {}
+	: length(0), time(0), cost(0) {}
 
 Result::Result(int length_, int time_)
-	: length(length_), time(time_) {}
+	: length(length_), time(time_), cost(0) {}
 
 Result Result::operator= (const Result &res) {
 	length = res.length;
 	time = res.time;
+	cost = res.cost;
 
 	return *this;
 }
@@ -109,13 +144,140 @@ Result Result::operator= (const Result &res) {
 int MAP_SIZE_ROW = 0;
 int MAP_SIZE_COL = 0;
 
+// move direction table -> UP, RIGHT, DOWN, LEFT, UP_RIGHT, DOWN_RIGHT, DOWN_LEFT, UP_LEFT
+// bit flag of direction d -> (1 << d), only first MOVE_DIR directions are used
+const int DIR_ROW[8] = {-1, 0, 1, 0, -1, 1, 1, -1};
+const int DIR_COL[8] = {0, 1, 0, -1, 1, 1, -1, -1};
+const int DIR_COST[8] = {STRAIGHT_COST, STRAIGHT_COST, STRAIGHT_COST, STRAIGHT_COST,
+						 DIAGONAL_COST, DIAGONAL_COST, DIAGONAL_COST, DIAGONAL_COST};
+
+// orthogonal sides of diagonal direction -> both must not be WALL (no corner cutting)
+const int DIR_SIDE[8] = {0, 0, 0, 0, 0x01 | 0x02, 0x04 | 0x02, 0x04 | 0x08, 0x01 | 0x08};
+
+// profile info -> phase time (ns) and search counters
+// every PROF_* macro expands to nothing without PROFILE
+#ifdef PROFILE
+typedef struct Profile {
+	long long parse_ns;
+	long long alloc_ns;
+	long long search_ns;
+	long long track_ns;
+	long long output_ns;
+
+	long long pushes;
+	long long pops;
+	long long reexpansions;
+	long long max_open;
+} Profile;
+
+Profile PROF;
+
+#define PROF_DECLARE(t)			chrono::steady_clock::time_point t = chrono::steady_clock::now()
+#define PROF_START(t)			(t = chrono::steady_clock::now())
+#define PROF_PHASE(phase, t)	(PROF.phase += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t).count())
+#define PROF_COUNT(counter)		(PROF.counter++)
+#define PROF_MAX(counter, v)	do { if (PROF.counter < static_cast<long long>(v)) PROF.counter = (v); } while (0)
+#define PROF_CLOSED(s, n)		vector<bool> s(n, false)
+#define PROF_EXPAND(s, idx)		do { PROF.pops++; if (s[idx]) PROF.reexpansions++; s[idx] = true; } while (0)
+#else
+#define PROF_DECLARE(t)
+#define PROF_START(t)
+#define PROF_PHASE(phase, t)
+#define PROF_COUNT(counter)
+#define PROF_MAX(counter, v)
+#define PROF_CLOSED(s, n)
+#define PROF_EXPAND(s, idx)
+#endif
+
+// trace record -> expanded cell, length from start (-1 in GBS), length to goal, open list size
+// 16 bytes per expansion, TRACE_EXPAND expands to nothing without TRACE
+#ifdef TRACE
+typedef struct TraceRecord {
+	uint32_t cell;
+	int32_t length_from_start;
+	int32_t length_to_goal;
+	uint32_t open_size;
+} TraceRecord;
+
+// trace file header, followed by
+//   TraceRecord record[record_num] -> oldest expansion first, older ones are overwritten in the ring
+typedef struct TraceHeader {
+	char magic[4];
+	int32_t row;
+	int32_t col;
+	uint32_t record_num;
+	uint64_t expansions;
+} TraceHeader;
+
+// ring buffer of trace records -> one store and one index update per expansion, no allocation
+typedef struct TraceRing {
+	TraceRing();
+	void push(int, int, int, size_t);
+	bool dump(const string &, int, int) const;
+
+	vector<TraceRecord> record;
+	uint32_t next;
+	uint64_t expansions;
+} TraceRing;
+
+TraceRing TRACE_RING;
+
+#define TRACE_EXPAND(idx, g, h, open)	TRACE_RING.push(idx, g, h, open)
+#else
+#define TRACE_EXPAND(idx, g, h, open)
+#endif
+
+#ifdef TRACE
+TraceRing::TraceRing()
+	: record(TRACE_CAPACITY), next(0), expansions(0) {}
+
+inline void TraceRing::push(int cell, int length_from_start, int length_to_goal, size_t open_size) {
+	TraceRecord &r = record[next];
+	r.cell = static_cast<uint32_t>(cell);
+	r.length_from_start = length_from_start;
+	r.length_to_goal = length_to_goal;
+	r.open_size = static_cast<uint32_t>(open_size);
+
+	if (++next == TRACE_CAPACITY)
+		next = 0;
+	expansions++;
+}
+
+// write header and kept records in expansion order
+bool TraceRing::dump(const string &filename, int row, int col) const {
+	TraceHeader header;
+	memcpy(header.magic, "TRC1", 4);
+	header.row = row;
+	header.col = col;
+	header.record_num = static_cast<uint32_t>(min<uint64_t>(expansions, TRACE_CAPACITY));
+	header.expansions = expansions;
+
+	ofstream trace_f(filename, ios::binary);
+	if (!trace_f.is_open())
+		return false;
+
+	// ring wrapped -> oldest kept record is at next
+	uint32_t first = (expansions > TRACE_CAPACITY) ? next : 0;
+	trace_f.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	trace_f.write(reinterpret_cast<const char *>(record.data() + first), sizeof(TraceRecord) * (header.record_num - first));
+	trace_f.write(reinterpret_cast<const char *>(record.data()), sizeof(TraceRecord) * first);
+
+	return trace_f.good();
+}
+#endif
+
 Result calc(Map **, int, int, Point &, vector<Point> &);
 int findPossibleMoves(Map **, CheckMap **, int, int, Point &);
 int shortestLength(int, int, vector<Point> &);
+int moveCost(int, int, int);
 
 int main () {
 	string input_filename = "input.txt";
 	string output_filename = "output.txt";
+#ifdef TRACE
+	string trace_filename = "trace.bin";
+#endif
+	PROF_DECLARE(phase_t);
 
 	// open input.txt
 	ifstream input_f(input_filename);
@@ -138,7 +300,7 @@ int main () {
 	int row = 0;
 	int col = 0;
 	input_f >> row >> col;
-	if (row <= 0 || row > 500 || col <= 0 || col > 500) {
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
 		cerr << "row or col value error" << endl;
 		return -1;
 	}
@@ -148,16 +310,19 @@ int main () {
 	MAP_SIZE_COL = col;
 
 	// allocate map array data
+	PROF_START(phase_t);
 	Map **map_info = NULL;
 	map_info = new Map *[row];
 	for (int i = 0; i < row; i++)
 		map_info[i] = new Map[col];
+	PROF_PHASE(alloc_ns, phase_t);
 
 	int map_1cell_data = 0;
 	int row_i = 0;
 	int col_j = 0;
 
 	// get map data from input.txt and fill map array data
+	PROF_START(phase_t);
 	Point start;
 	vector<Point> goal;
 	Result result;
@@ -220,10 +385,13 @@ int main () {
 		goto RELEASE_DATA;
 	}
 
+	PROF_PHASE(parse_ns, phase_t);
+
 	// calc best result
 	result = calc(map_info, row, col, start, goal);
 
 	// write
+	PROF_START(phase_t);
 	for (int i = 0; i < row; i++) {
 		for (int j = 0; j < col; j++) {
 			output_f << static_cast<int>(map_info[i][j]) << " ";
@@ -236,6 +404,9 @@ int main () {
 	// best result
 	if (result.length != -1) {
 		output_f << "length=" << result.length << endl;
+#if MOVE_DIR == 8
+		output_f << "cost=" << result.cost << endl;
+#endif
 		output_f << "time=" << result.time << endl;
 	}
 	// no result
@@ -243,6 +414,27 @@ int main () {
 		output_f << "time=" << result.time << endl;
 		output_f << "no result" << endl;
 	}
+	PROF_PHASE(output_ns, phase_t);
+
+#ifdef PROFILE
+	// profile block
+	output_f << "---" << endl;
+	output_f << "parse_ns=" << PROF.parse_ns << endl;
+	output_f << "alloc_ns=" << PROF.alloc_ns << endl;
+	output_f << "search_ns=" << PROF.search_ns << endl;
+	output_f << "track_ns=" << PROF.track_ns << endl;
+	output_f << "output_ns=" << PROF.output_ns << endl;
+	output_f << "pushes=" << PROF.pushes << endl;
+	output_f << "pops=" << PROF.pops << endl;
+	output_f << "reexpansions=" << PROF.reexpansions << endl;
+	output_f << "max_open=" << PROF.max_open << endl;
+#endif
+
+#ifdef TRACE
+	// expansion trace next to output.txt -> render with ./HEAT
+	if (!TRACE_RING.dump(trace_filename, row, col))
+		cerr << "trace file cannot be written" << endl;
+#endif
 
 RELEASE_DATA:
 	input_f.close();
@@ -257,10 +449,13 @@ RELEASE_DATA:
 
 // calc result road using greedy best-first search algorithm
 Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal) {
-	Node root(start.row, start.col);
 	CheckMap **search_map;
 	Result res;
-	vector<Node *> all_nodes;
+	PROF_DECLARE(phase_t);
+	PROF_CLOSED(expanded, row * col);
+
+	// per-cell parent cell index
+	vector<int> parent(row * col, -1);
 
 	// make check map -> after searching, set to UNCHECKED
 	search_map = new CheckMap *[row];
@@ -277,131 +472,111 @@ Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal) {
 		search_map[goal[i].row][goal[i].col] = CheckMap::GOAL;
 
 	// search biggest score point first
-	priority_queue<Node *, vector<Node *>, Compare> search_queue;
-	search_queue.push(&root);
-	Node *goal_node = NULL;
+	int start_idx = start.row * col + start.col;
+	parent[start_idx] = start_idx;
+
+	// cell index offset of every direction
+	int dir_offset[8];
+	for (int d = 0; d < 8; d++)
+		dir_offset[d] = DIR_ROW[d] * col + DIR_COL[d];
+
+	priority_queue<OpenNode, vector<OpenNode>, greater<OpenNode> > search_queue;
+	search_queue.emplace(0, start_idx);
+	PROF_COUNT(pushes);
+	int goal_idx = -1;
+	PROF_PHASE(alloc_ns, phase_t);
 
 	// search continuously until finding result
 	// search_queue is empty when there is no result
+	PROF_START(phase_t);
 	while (!search_queue.empty()) {
-		Node *cur_node = search_queue.top();
+		int cur_idx = search_queue.top().cell;
+		TRACE_EXPAND(cur_idx, -1, search_queue.top().length, search_queue.size());
 		search_queue.pop();
-		all_nodes.push_back(cur_node);
 
 		res.time++;
 
-		Point cur_p(cur_node->p.row, cur_node->p.col);
+		Point cur_p(cur_idx / col, cur_idx % col);
+		PROF_EXPAND(expanded, cur_idx);
 
 		// check if goal node
 		if (map[cur_p.row][cur_p.col] == Map::GOAL) {
-			goal_node = cur_node;
+			goal_idx = cur_idx;
 			break;
 		}
 
 		// search possible way
-		// bit flag -> 0x01(up), 0x02(right), 0x04(down), 0x08(left)
 		int move_flag = findPossibleMoves(map, search_map, row, col, cur_p);
 
-		// UP
-		if (move_flag & 0x01) {
-			Node *up_node = new Node(cur_p.row-1, cur_p.col, cur_node);
-			up_node->length = shortestLength(cur_p.row-1, cur_p.col, goal);
-			search_queue.push(up_node);
-		}
-
-		// RIGHT
-		if (move_flag & 0x02) {
-			Node *right_node = new Node(cur_p.row, cur_p.col+1, cur_node);
-			right_node->length = shortestLength(cur_p.row, cur_p.col+1, goal);
-			search_queue.push(right_node);
+		// push every possible direction from neighbour table
+		for (int d = 0; d < MOVE_DIR; d++) {
+			if (move_flag & (1 << d)) {
+				int next_idx = cur_idx + dir_offset[d];
+				parent[next_idx] = cur_idx;
+				search_queue.emplace(shortestLength(cur_p.row + DIR_ROW[d], cur_p.col + DIR_COL[d], goal), next_idx);
+				PROF_COUNT(pushes);
+			}
 		}
 
-		// DOWN
-		if (move_flag & 0x04) {
-			Node *down_node = new Node(cur_p.row+1, cur_p.col, cur_node);
-			down_node->length = shortestLength(cur_p.row+1, cur_p.col, goal);
-			search_queue.push(down_node);
-		}
-
-		// LEFT
-		if (move_flag & 0x08) {
-			Node *left_node = new Node(cur_p.row, cur_p.col-1, cur_node);
-			left_node->length = shortestLength(cur_p.row, cur_p.col-1, goal);
-			search_queue.push(left_node);
-		}
+		PROF_MAX(max_open, search_queue.size());
 	}
+	PROF_PHASE(search_ns, phase_t);
 
 	// make result road to start point from goal
-	if (goal_node) {
-		Node *track_road = goal_node->parent;
-		while (track_road->p != start) {
-			map[track_road->p.row][track_road->p.col] = Map::ROAD_G;
+	PROF_START(phase_t);
+	if (goal_idx != -1) {
+		res.cost = moveCost(goal_idx, parent[goal_idx], col);
+		int track_road = parent[goal_idx];
+		while (track_road != start_idx) {
+			map[track_road / col][track_road % col] = Map::ROAD_G;
 			res.length++;
+			res.cost += moveCost(track_road, parent[track_road], col);
 
-			track_road = track_road->parent;
+			track_road = parent[track_road];
 		}
 	}
 	// no result
 	else
 		res.length = -1;
+	PROF_PHASE(track_ns, phase_t);
 
 	// free datum
+	PROF_START(phase_t);
 	for (int i = 0; i < row; i++)
 		delete[] search_map[i];
 	delete[] search_map;
-
-	// all_nodes[0] -> root node
-	for (uint i = 1; i < all_nodes.size(); i++)
-		delete all_nodes[i];
-	
-	while (!search_queue.empty()) {
-		Node *delete_node = search_queue.top();
-		search_queue.pop();
-
-		delete delete_node;
-	}
+	PROF_PHASE(alloc_ns, phase_t);
 
 	return res;
 }
 
 // find possible direction from current point
+// bit flag -> 0x01(up), 0x02(right), 0x04(down), 0x08(left)
+//             0x10(up-right), 0x20(down-right), 0x40(down-left), 0x80(up-left) in 8 direction mode
 int findPossibleMoves(Map **map, CheckMap **search_map, int row, int col, Point &p) {
 	int result = 0;
+	int side_flag = 0;
 
-	// UP
-	if (p.row > 0 && 
-			(map[p.row-1][p.col] == Map::ROAD || map[p.row-1][p.col] == Map::GOAL) &&
-			(search_map[p.row-1][p.col] == CheckMap::UNCHECKED || search_map[p.row-1][p.col] == CheckMap::GOAL)) {
+	// orthogonal directions come first -> side_flag is ready for diagonal directions
+	for (int d = 0; d < MOVE_DIR; d++) {
+		int next_row = p.row + DIR_ROW[d];
+		int next_col = p.col + DIR_COL[d];
+		if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+			continue;
 
-		result |= 0x01;
-		search_map[p.row-1][p.col] = CheckMap::CHECKED;
-	}
+		Map next_cell = map[next_row][next_col];
+		if (next_cell != Map::WALL)
+			side_flag |= (1 << d);
 
-	// RIGHT
-	if (p.col < MAP_SIZE_COL - 1 && 
-			(map[p.row][p.col+1] == Map::ROAD || map[p.row][p.col+1] == Map::GOAL) &&
-			(search_map[p.row][p.col+1] == CheckMap::UNCHECKED || search_map[p.row][p.col+1] == CheckMap::GOAL)) {
+		if ((side_flag & DIR_SIDE[d]) != DIR_SIDE[d])
+			continue;
 
-		result |= 0x02;
-		search_map[p.row][p.col+1] = CheckMap::CHECKED;
-	}
-
-	// DOWN
-	if (p.row < MAP_SIZE_ROW - 1 && 
-			(map[p.row+1][p.col] == Map::ROAD || map[p.row+1][p.col] == Map::GOAL) &&
-			(search_map[p.row+1][p.col] == CheckMap::UNCHECKED || search_map[p.row+1][p.col] == CheckMap::GOAL)) {
-
-		result |= 0x04;
-		search_map[p.row+1][p.col] = CheckMap::CHECKED;
-	}
-
-	// LEFT
-	if (p.col > 0 && 
-			(map[p.row][p.col-1] == Map::ROAD || map[p.row][p.col-1] == Map::GOAL) &&
-			(search_map[p.row][p.col-1] == CheckMap::UNCHECKED || search_map[p.row][p.col-1] == CheckMap::GOAL)) {
+		if ((next_cell == Map::ROAD || next_cell == Map::GOAL) &&
+				(search_map[next_row][next_col] == CheckMap::UNCHECKED || search_map[next_row][next_col] == CheckMap::GOAL)) {
 
-		result |= 0x08;
-		search_map[p.row][p.col-1] = CheckMap::CHECKED;
+			result |= (1 << d);
+			search_map[next_row][next_col] = CheckMap::CHECKED;
+		}
 	}
 
 	return result;
@@ -409,7 +584,7 @@ int findPossibleMoves(Map **map, CheckMap **search_map, int row, int col, Point
 
 // calc shortest length to several goals
 int shortestLength(int row, int col, vector<Point> &goal) {
-	int length = MAP_SIZE_ROW + MAP_SIZE_COL;
+	int length = INT_MAX;
 
 	Point cur_p(row, col);
 	for (uint i = 0; i < goal.size(); i++) {
@@ -421,3 +596,11 @@ int shortestLength(int row, int col, vector<Point> &goal) {
 
 	return length;
 }
+
+// move cost between two neighbour cells
+int moveCost(int cell1, int cell2, int col) {
+	if (cell1 / col != cell2 / col && cell1 % col != cell2 % col)
+		return DIAGONAL_COST;
+
+	return STRAIGHT_COST;
+}
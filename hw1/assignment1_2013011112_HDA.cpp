@@ -0,0 +1,653 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// messages per batch sent to an owner thread, expansions between flushes of partial batches
+#define MESSAGE_BATCH		64
+#define FLUSH_EXPANSIONS	16
+
+// cell state bits -> direction from parent (2 bits), expanded at least once
+#define STATE_DIR		0x03
+#define STATE_EXPANDED	0x04
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell index
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+} OpenNode;
+
+// result info -> length, time (expanded cells of all threads), remote messages, re-expanded cells,
+// max / average expansions of threads, search seconds
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+	long long messages;
+	long long reexpansions;
+	double imbalance;
+	double seconds;
+} Result;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// message -> generated cell, length from start, length to goal, direction from parent
+typedef struct Message {
+	int cell;
+	int length;
+	int length_to_goal;
+	int dir;
+} Message;
+
+// batch of messages to one owner thread, linked in the inbox of the owner
+typedef struct MessageBatch {
+	MessageBatch();
+
+	MessageBatch *next;
+	int count;
+	Message msg[MESSAGE_BATCH];
+} MessageBatch;
+
+// lock-free multi-producer single-consumer inbox -> producers push batches with CAS,
+// the owner takes the whole list with one exchange, so a batch is never removed by two threads
+// padded to a cache line -> inboxes of different threads do not share a line
+typedef struct Inbox {
+	Inbox();
+	void push(MessageBatch *);
+	MessageBatch *takeAll();
+
+	atomic<MessageBatch *> head;
+	char padding[64 - sizeof(atomic<MessageBatch *>)];
+} Inbox;
+
+// shared search state -> every cell is owned by one thread through a hash of its block
+// length and state of a cell are read and written only by its owner thread
+// work = busy threads + batches in flight, search is over when it drops to 0
+typedef struct HdaSearch {
+	HdaSearch(Map **, int, int, vector<Point> &, int, int);
+	int owner(int) const;
+	int incumbentLength() const;
+	void offerGoal(int, int);
+
+	Map **map;
+	int row;
+	int col;
+	vector<Point> &goal;
+	int thread_num;
+	int block;
+	int block_col_num;
+
+	vector<int> length;
+	vector<uint8_t> state;
+	vector<Inbox> inbox;
+	atomic<uint64_t> incumbent;
+	atomic<int> work;
+} HdaSearch;
+
+// worker thread -> open list of owned cells with lazy deletion, one outgoing batch per owner thread
+typedef struct Worker {
+	Worker(HdaSearch *, int);
+	void run();
+	void expand(const OpenNode &);
+	void receive(const Message &);
+	void send(int, const Message &);
+	void flush(int);
+	void flushAll();
+
+	HdaSearch *search;
+	int id;
+	priority_queue<OpenNode, vector<OpenNode>, greater<OpenNode> > search_queue;
+	vector<MessageBatch *> outgoing;
+	bool busy;
+
+	long long expansions;
+	long long reexpansions;
+	long long messages;
+} Worker;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+Result::Result()
+	: length(0), time(0), messages(0), reexpansions(0), imbalance(0.0), seconds(0.0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_), messages(0), reexpansions(0), imbalance(0.0), seconds(0.0) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+	messages = res.messages;
+	reexpansions = res.reexpansions;
+	imbalance = res.imbalance;
+	seconds = res.seconds;
+
+	return *this;
+}
+
+MessageBatch::MessageBatch()
+	: next(NULL), count(0) {}
+
+Inbox::Inbox()
+	: head(NULL) {}
+
+void Inbox::push(MessageBatch *batch) {
+	MessageBatch *old_head = head.load(memory_order_relaxed);
+	do {
+		batch->next = old_head;
+	} while (!head.compare_exchange_weak(old_head, batch, memory_order_release, memory_order_relaxed));
+}
+
+// take every batch pushed so far, NULL when inbox is empty
+MessageBatch *Inbox::takeAll() {
+	if (head.load(memory_order_relaxed) == NULL)
+		return NULL;
+
+	return head.exchange(NULL, memory_order_acquire);
+}
+
+// every thread starts busy, incumbent (length << 32 | goal cell) starts with no goal
+HdaSearch::HdaSearch(Map **map_, int row_, int col_, vector<Point> &goal_, int thread_num_, int block_)
+	: map(map_), row(row_), col(col_), goal(goal_), thread_num(thread_num_), block(block_),
+	  length(static_cast<size_t>(row_) * col_, INT_MAX), state(static_cast<size_t>(row_) * col_, 0),
+	  inbox(thread_num_), incumbent(UINT64_MAX), work(thread_num_) {
+	block_col_num = (col + block - 1) / block;
+}
+
+// owner thread of cell -> multiplicative hash of its block
+// block x block cells share an owner, so most neighbours stay local while blocks spread over threads
+int HdaSearch::owner(int cell) const {
+	uint64_t block_id = static_cast<uint64_t>(cell / col / block) * block_col_num + cell % col / block;
+
+	return static_cast<int>(((block_id + 1) * 0x9E3779B97F4A7C15ULL >> 32) % thread_num);
+}
+
+// length of best goal found so far, INT_MAX without goal
+int HdaSearch::incumbentLength() const {
+	uint64_t cur = incumbent.load(memory_order_relaxed);
+
+	return (cur == UINT64_MAX) ? INT_MAX : static_cast<int>(cur >> 32);
+}
+
+// keep goal cell when its length beats the incumbent
+void HdaSearch::offerGoal(int goal_length, int cell) {
+	uint64_t offer = (static_cast<uint64_t>(goal_length) << 32) | static_cast<uint32_t>(cell);
+	uint64_t cur = incumbent.load();
+	while (offer < cur && !incumbent.compare_exchange_weak(cur, offer));
+}
+
+Worker::Worker(HdaSearch *search_, int id_)
+	: search(search_), id(id_), outgoing(search_->thread_num, NULL), busy(true),
+	  expansions(0), reexpansions(0), messages(0) {}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+// UP, RIGHT, DOWN, LEFT
+const int DIR_ROW[4] = {-1, 0, 1, 0};
+const int DIR_COL[4] = {0, 1, 0, -1};
+
+Result calc(Map **, int, int, Point &, vector<Point> &, int, int);
+int shortestLength(int, int, vector<Point> &);
+
+// usage: ./HDA [threads] [block] -> hash distributed A* with threads workers (hardware threads by default)
+// cells are owned in block x block groups (4 by default, 1 -> every cell hashed on its own)
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// worker threads and owner block size
+	int thread_num = static_cast<int>(thread::hardware_concurrency());
+	if (argc > 1)
+		thread_num = atoi(argv[1]);
+	if (thread_num <= 0)
+		thread_num = 1;
+
+	int block = (argc > 2) ? atoi(argv[2]) : 4;
+	if (block <= 0) {
+		cerr << "block value error" << endl;
+		return -1;
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	Point start;
+	vector<Point> goal;
+	Result result;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// calc best result
+	result = calc(map_info, row, col, start, goal, thread_num, block);
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// best result
+	if (result.length != -1) {
+		output_f << "length=" << result.length << endl;
+		output_f << "time=" << result.time << endl;
+	}
+	// no result
+	else {
+		output_f << "time=" << result.time << endl;
+		output_f << "no result" << endl;
+	}
+
+	output_f << "threads=" << thread_num << endl;
+	output_f << "block=" << block << endl;
+	output_f << "messages=" << result.messages << endl;
+	output_f << "reexpansions=" << result.reexpansions << endl;
+	output_f << "load_imbalance=" << result.imbalance << endl;
+	output_f << "search_ms=" << static_cast<long long>(result.seconds * 1000.0) << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// calc result road using hash distributed A* (HDA*)
+// every thread expands only cells it owns and sends generated cells to their owner through its inbox
+// a cell is opened again whenever a shorter length arrives, so the search stops with an optimal length
+// once no thread has an open cell better than the incumbent goal and no batch is in flight
+Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal, int thread_num, int block) {
+	Result res;
+	HdaSearch search(map, row, col, goal, thread_num, block);
+
+	vector<Worker> worker;
+	for (int t = 0; t < thread_num; t++)
+		worker.emplace_back(&search, t);
+
+	// start cell is opened by its owner before workers run
+	int start_idx = start.row * col + start.col;
+	int start_length_to_goal = shortestLength(start.row, start.col, goal);
+	search.length[start_idx] = 0;
+	worker[search.owner(start_idx)].search_queue.push(OpenNode(start_length_to_goal, start_length_to_goal, start_idx));
+
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+
+	vector<thread> workers;
+	for (int t = 0; t < thread_num; t++)
+		workers.emplace_back(&Worker::run, &worker[t]);
+	for (int t = 0; t < thread_num; t++)
+		workers[t].join();
+
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	res.seconds = chrono::duration<double>(end - begin).count();
+
+	long long max_expansions = 0;
+	long long total_expansions = 0;
+	for (int t = 0; t < thread_num; t++) {
+		total_expansions += worker[t].expansions;
+		max_expansions = max(max_expansions, worker[t].expansions);
+		res.reexpansions += worker[t].reexpansions;
+		res.messages += worker[t].messages;
+	}
+
+	res.time = static_cast<int>(total_expansions);
+	res.imbalance = (total_expansions > 0) ? static_cast<double>(max_expansions) * thread_num / total_expansions : 0.0;
+
+	// make result road to start point from goal -> lengths along parents strictly decrease down to start
+	uint64_t best = search.incumbent.load();
+	if (best != UINT64_MAX) {
+		int goal_idx = static_cast<int>(best & 0xFFFFFFFFULL);
+		int track_road = goal_idx - DIR_ROW[search.state[goal_idx] & STATE_DIR] * col - DIR_COL[search.state[goal_idx] & STATE_DIR];
+		while (track_road != start_idx) {
+			map[track_road / col][track_road % col] = Map::ROAD_G;
+			res.length++;
+
+			int d = search.state[track_road] & STATE_DIR;
+			track_road -= DIR_ROW[d] * col + DIR_COL[d];
+		}
+	}
+	// no result
+	else
+		res.length = -1;
+
+	return res;
+}
+
+// worker loop -> take inbox, expand one open cell, go idle when nothing better than incumbent is left
+// a thread adds itself to work before it drops received batches, and adds sent batches while it is busy,
+// so work is 0 only when every thread is idle with an empty inbox and nothing can wake them again
+void Worker::run() {
+	int since_flush = 0;
+
+	while (true) {
+		MessageBatch *batch = search->inbox[id].takeAll();
+		if (batch != NULL) {
+			if (!busy) {
+				search->work.fetch_add(1);
+				busy = true;
+			}
+
+			int batch_num = 0;
+			while (batch != NULL) {
+				for (int i = 0; i < batch->count; i++)
+					receive(batch->msg[i]);
+
+				MessageBatch *next = batch->next;
+				delete batch;
+				batch = next;
+				batch_num++;
+			}
+
+			search->work.fetch_sub(batch_num);
+		}
+
+		// best open cell -> skip stale nodes, drop the whole open list once it cannot beat the incumbent
+		bool expanded = false;
+		int incumbent_length = search->incumbentLength();
+		while (!search_queue.empty()) {
+			OpenNode node = search_queue.top();
+			if (node.score >= incumbent_length) {
+				priority_queue<OpenNode, vector<OpenNode>, greater<OpenNode> >().swap(search_queue);
+				break;
+			}
+
+			search_queue.pop();
+			if (node.score - node.length_to_goal != search->length[node.cell])
+				continue;
+
+			expand(node);
+			expanded = true;
+			break;
+		}
+
+		if (expanded) {
+			if (++since_flush >= FLUSH_EXPANSIONS) {
+				flushAll();
+				since_flush = 0;
+			}
+
+			continue;
+		}
+
+		// nothing to expand -> send partial batches and go idle
+		flushAll();
+		since_flush = 0;
+		if (busy) {
+			busy = false;
+			search->work.fetch_sub(1);
+		}
+
+		if (search->work.load() == 0)
+			break;
+
+		this_thread::yield();
+	}
+}
+
+// expand owned cell -> goal cell is offered as incumbent, neighbours go to their owner
+void Worker::expand(const OpenNode &node) {
+	int cur_idx = node.cell;
+	int cur_length = node.score - node.length_to_goal;
+	int row = search->row;
+	int col = search->col;
+
+	expansions++;
+	if (search->state[cur_idx] & STATE_EXPANDED)
+		reexpansions++;
+	search->state[cur_idx] |= STATE_EXPANDED;
+
+	Point cur_p(cur_idx / col, cur_idx % col);
+	if (search->map[cur_p.row][cur_p.col] == Map::GOAL) {
+		search->offerGoal(cur_length, cur_idx);
+		return;
+	}
+
+	int incumbent_length = search->incumbentLength();
+	for (int d = 0; d < 4; d++) {
+		int next_row = cur_p.row + DIR_ROW[d];
+		int next_col = cur_p.col + DIR_COL[d];
+		if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+			continue;
+		if (search->map[next_row][next_col] == Map::WALL || search->map[next_row][next_col] == Map::START)
+			continue;
+
+		Message msg;
+		msg.cell = next_row * col + next_col;
+		msg.length = cur_length + 1;
+		msg.length_to_goal = shortestLength(next_row, next_col, search->goal);
+		msg.dir = d;
+		if (msg.length + msg.length_to_goal >= incumbent_length)
+			continue;
+
+		int next_owner = search->owner(msg.cell);
+		if (next_owner == id)
+			receive(msg);
+		else
+			send(next_owner, msg);
+	}
+}
+
+// open owned cell again when msg has a shorter length
+void Worker::receive(const Message &msg) {
+	if (msg.length >= search->length[msg.cell])
+		return;
+
+	search->length[msg.cell] = msg.length;
+	search->state[msg.cell] = (search->state[msg.cell] & STATE_EXPANDED) | static_cast<uint8_t>(msg.dir);
+	search_queue.push(OpenNode(msg.length + msg.length_to_goal, msg.length_to_goal, msg.cell));
+}
+
+// add message to outgoing batch of owner, full batch is sent at once
+void Worker::send(int owner, const Message &msg) {
+	if (outgoing[owner] == NULL)
+		outgoing[owner] = new MessageBatch();
+
+	MessageBatch *batch = outgoing[owner];
+	batch->msg[batch->count++] = msg;
+	messages++;
+
+	if (batch->count == MESSAGE_BATCH)
+		flush(owner);
+}
+
+// batch counts as work before it is visible in the inbox
+void Worker::flush(int owner) {
+	if (outgoing[owner] == NULL)
+		return;
+
+	search->work.fetch_add(1);
+	search->inbox[owner].push(outgoing[owner]);
+	outgoing[owner] = NULL;
+}
+
+void Worker::flushAll() {
+	for (int t = 0; t < search->thread_num; t++)
+		flush(t);
+}
+
+// calc shortest length to several goals
+int shortestLength(int row, int col, vector<Point> &goal) {
+	int length = INT_MAX;
+
+	Point cur_p(row, col);
+	for (uint i = 0; i < goal.size(); i++) {
+		int curLength = DISTANCE(cur_p, goal[i]);
+
+		if (length > curLength)
+			length = curLength;
+	}
+
+	return length;
+}
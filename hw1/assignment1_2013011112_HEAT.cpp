@@ -0,0 +1,185 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// gray levels -> WALL, never expanded, least and most expanded (or latest and earliest)
+#define LEVEL_WALL		0
+#define LEVEL_UNSEEN	32
+#define LEVEL_LOW		64
+#define LEVEL_HIGH		255
+
+using namespace std;
+
+// trace record -> expanded cell, length from start, length to goal, open list size
+// same layout as the recorder of -DTRACE builds
+typedef struct TraceRecord {
+	uint32_t cell;
+	int32_t length_from_start;
+	int32_t length_to_goal;
+	uint32_t open_size;
+} TraceRecord;
+
+// trace file header, followed by
+//   TraceRecord record[record_num] -> oldest expansion first
+typedef struct TraceHeader {
+	char magic[4];
+	int32_t row;
+	int32_t col;
+	uint32_t record_num;
+	uint64_t expansions;
+} TraceHeader;
+
+// heatmap mode
+typedef enum class HeatMode {
+	COUNT = 0,
+	ORDER = 1
+} HeatMode;
+
+bool readWall(const string &, int, int, vector<uint8_t> &);
+
+// usage: ./HEAT [trace_file] [pgm_file] [count|order] -> render trace.bin of ASS/GBS built with -DTRACE as heatmap.pgm
+// count -> expansions of every cell on log scale (default), order -> first expansion of every cell, earliest is brightest
+// WALL cells of input.txt are black when it has the size of the traced map
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string trace_filename = (argc > 1) ? argv[1] : "trace.bin";
+	string pgm_filename = (argc > 2) ? argv[2] : "heatmap.pgm";
+
+	// heatmap mode
+	HeatMode mode = HeatMode::COUNT;
+	if (argc > 3) {
+		if (strcmp(argv[3], "order") == 0)
+			mode = HeatMode::ORDER;
+		else if (strcmp(argv[3], "count") != 0) {
+			cerr << "unknown mode " << argv[3] << endl;
+			return -1;
+		}
+	}
+
+	// open trace file
+	ifstream trace_f(trace_filename, ios::binary);
+	if (!trace_f.is_open()) {
+		cerr << "trace file is not exist" << endl;
+
+		return -1;
+	}
+
+	TraceHeader header;
+	trace_f.read(reinterpret_cast<char *>(&header), sizeof(header));
+	if (!trace_f.good() || memcmp(header.magic, "TRC1", 4) != 0) {
+		cerr << "trace file header error" << endl;
+		return -1;
+	}
+
+	int row = header.row;
+	int col = header.col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// expansions and first expansion of every cell
+	int cell_num = row * col;
+	vector<uint32_t> count(cell_num, 0);
+	vector<uint32_t> first(cell_num, UINT32_MAX);
+	vector<TraceRecord> record(header.record_num);
+	trace_f.read(reinterpret_cast<char *>(record.data()), sizeof(TraceRecord) * record.size());
+	if (!trace_f.good()) {
+		cerr << "trace file do not have sufficient records" << endl;
+		return -1;
+	}
+
+	uint32_t max_count = 0;
+	uint32_t max_open = 0;
+	for (uint32_t i = 0; i < header.record_num; i++) {
+		uint32_t cell = record[i].cell;
+		if (cell >= static_cast<uint32_t>(cell_num)) {
+			cerr << "trace record has unknown cell" << endl;
+			return -1;
+		}
+
+		count[cell]++;
+		first[cell] = min(first[cell], i);
+		max_count = max(max_count, count[cell]);
+		max_open = max(max_open, record[i].open_size);
+	}
+
+	// WALL cells of input.txt, none when it is missing or another map
+	vector<uint8_t> wall;
+	bool has_wall = readWall(input_filename, row, col, wall);
+
+	// gray level of every cell
+	vector<uint8_t> pixel(cell_num);
+	int expanded_num = 0;
+	for (int i = 0; i < cell_num; i++) {
+		if (count[i] == 0) {
+			pixel[i] = (has_wall && !wall[i]) ? LEVEL_UNSEEN : LEVEL_WALL;
+			continue;
+		}
+
+		double level = 1.0;
+		if (mode == HeatMode::COUNT && max_count > 1)
+			level = log(static_cast<double>(count[i])) / log(static_cast<double>(max_count));
+		else if (mode == HeatMode::ORDER && header.record_num > 1)
+			level = 1.0 - static_cast<double>(first[i]) / (header.record_num - 1);
+
+		pixel[i] = static_cast<uint8_t>(LEVEL_LOW + lround(level * (LEVEL_HIGH - LEVEL_LOW)));
+		expanded_num++;
+	}
+
+	// write binary pgm
+	ofstream pgm_f(pgm_filename, ios::binary);
+	if (!pgm_f.is_open()) {
+		cerr << "pgm file cannot be opened" << endl;
+		return -1;
+	}
+
+	pgm_f << "P5\n" << col << " " << row << "\n255\n";
+	pgm_f.write(reinterpret_cast<const char *>(pixel.data()), pixel.size());
+	pgm_f.close();
+
+	// summary
+	cout << "expansions=" << header.expansions << endl;
+	cout << "records=" << header.record_num << endl;
+	cout << "dropped=" << header.expansions - header.record_num << endl;
+	cout << "expanded_cells=" << expanded_num << endl;
+	cout << "max_count=" << max_count << endl;
+	cout << "max_open=" << max_open << endl;
+
+	return 0;
+}
+
+// read WALL flag of every cell from map file of row x col cells
+bool readWall(const string &filename, int row, int col, vector<uint8_t> &wall) {
+	ifstream input_f(filename);
+	if (!input_f.is_open())
+		return false;
+
+	int map_row = 0;
+	int map_col = 0;
+	input_f >> map_row >> map_col;
+	if (map_row != row || map_col != col)
+		return false;
+
+	wall.assign(row * col, 0);
+	int map_1cell_data = 0;
+	for (int i = 0; i < row * col; i++) {
+		if (!(input_f >> map_1cell_data))
+			return false;
+
+		wall[i] = (map_1cell_data == 1);
+	}
+
+	return true;
+}
@@ -3,6 +3,16 @@
 #include <string>
 #include <vector>
 
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// per-phase timers and search counters -> build with -DPROFILE to enable
+#ifdef PROFILE
+#include <chrono>
+#endif
+
 using namespace std;
 
 // point info -> (row, col)
@@ -93,12 +103,48 @@ Result Result::operator= (const Result &res) {
 int MAP_SIZE_ROW = 0;
 int MAP_SIZE_COL = 0;
 
+// profile info -> phase time (ns) and search counters
+// every PROF_* macro expands to nothing without PROFILE
+#ifdef PROFILE
+typedef struct Profile {
+	long long parse_ns;
+	long long alloc_ns;
+	long long search_ns;
+	long long track_ns;
+	long long output_ns;
+
+	long long pushes;
+	long long pops;
+	long long reexpansions;
+	long long max_open;
+} Profile;
+
+Profile PROF;
+
+#define PROF_DECLARE(t)			chrono::steady_clock::time_point t = chrono::steady_clock::now()
+#define PROF_START(t)			(t = chrono::steady_clock::now())
+#define PROF_PHASE(phase, t)	(PROF.phase += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t).count())
+#define PROF_COUNT(counter)		(PROF.counter++)
+#define PROF_MAX(counter, v)	do { if (PROF.counter < static_cast<long long>(v)) PROF.counter = (v); } while (0)
+#define PROF_CLOSED(s, n)		vector<bool> s(n, false)
+#define PROF_EXPAND(s, idx)		do { PROF.pops++; if (s[idx]) PROF.reexpansions++; s[idx] = true; } while (0)
+#else
+#define PROF_DECLARE(t)
+#define PROF_START(t)
+#define PROF_PHASE(phase, t)
+#define PROF_COUNT(counter)
+#define PROF_MAX(counter, v)
+#define PROF_CLOSED(s, n)
+#define PROF_EXPAND(s, idx)
+#endif
+
 Result calc(Map **, int, int, Point &, vector<Point> &);
 bool findPossibleMoves(Map **, CheckMap**, Node *, vector<Node *> &);
 
 int main () {
 	string input_filename = "input.txt";
 	string output_filename = "output.txt";
+	PROF_DECLARE(phase_t);
 
 	// open input.txt
 	ifstream input_f(input_filename);
@@ -121,7 +167,7 @@ int main () {
 	int row = 0;
 	int col = 0;
 	input_f >> row >> col;
-	if (row <= 0 || row > 500 || col <= 0 || col > 500) {
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
 		cerr << "row or col value error" << endl;
 		return -1;
 	}
@@ -131,16 +177,19 @@ int main () {
 	MAP_SIZE_COL = col;
 
 	// allocate map array data
+	PROF_START(phase_t);
 	Map **map_info = NULL;
 	map_info = new Map *[row];
 	for (int i = 0; i < row; i++)
 		map_info[i] = new Map[col];
+	PROF_PHASE(alloc_ns, phase_t);
 
 	int map_1cell_data = 0;
 	int row_i = 0;
 	int col_j = 0;
 
 	// get map data from input.txt and fill map array data
+	PROF_START(phase_t);
 	Point start;
 	vector<Point> goal;
 	Result result;
@@ -203,10 +252,13 @@ int main () {
 		goto RELEASE_DATA;
 	}
 
+	PROF_PHASE(parse_ns, phase_t);
+
 	// calc best result
 	result = calc(map_info, row, col, start, goal);
 
 	// write
+	PROF_START(phase_t);
 	for (int i = 0; i < row; i++) {
 		for (int j = 0; j < col; j++) {
 			output_f << static_cast<int>(map_info[i][j]) << " ";
@@ -226,6 +278,21 @@ int main () {
 		output_f << "time=" << result.time << endl;
 		output_f << "no result" << endl;
 	}
+	PROF_PHASE(output_ns, phase_t);
+
+#ifdef PROFILE
+	// profile block
+	output_f << "---" << endl;
+	output_f << "parse_ns=" << PROF.parse_ns << endl;
+	output_f << "alloc_ns=" << PROF.alloc_ns << endl;
+	output_f << "search_ns=" << PROF.search_ns << endl;
+	output_f << "track_ns=" << PROF.track_ns << endl;
+	output_f << "output_ns=" << PROF.output_ns << endl;
+	output_f << "pushes=" << PROF.pushes << endl;
+	output_f << "pops=" << PROF.pops << endl;
+	output_f << "reexpansions=" << PROF.reexpansions << endl;
+	output_f << "max_open=" << PROF.max_open << endl;
+#endif
 
 RELEASE_DATA:
 	input_f.close();
@@ -240,6 +307,8 @@ RELEASE_DATA:
 
 Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal) {
 	Result res;
+	PROF_DECLARE(phase_t);
+	PROF_CLOSED(expanded, row * col);
 
 	// check the searched map info from older level -> ignore that space
 	CheckMap **searched_map;
@@ -270,12 +339,17 @@ Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal) {
 	int cur_level = 0;
 	bool found_goal = false;
 	Node *track_goal_road = NULL;
+	PROF_COUNT(pushes);
+	PROF_PHASE(alloc_ns, phase_t);
 
 	// find road to goal
+	PROF_START(phase_t);
 	while (node_container[cur_level].size() > 0) {
 		vector<Node *> cur_level_leaf_nodes;
+		PROF_MAX(max_open, node_container[cur_level].size());
 
 		for (int i = 0; i < node_container[cur_level].size(); i++) {	
+			PROF_EXPAND(expanded, node_container[cur_level][i]->p.row * col + node_container[cur_level][i]->p.col);
 			bool find_goal = findPossibleMoves(map, searched_map, node_container[cur_level][i], cur_level_leaf_nodes);
 			res.time++;
 
@@ -292,8 +366,10 @@ Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal) {
 		node_container.push_back(cur_level_leaf_nodes);
 		cur_level++;
 	}
+	PROF_PHASE(search_ns, phase_t);
 
 	// set Map::ROAD_G
+	PROF_START(phase_t);
 	if (track_goal_road != NULL) {
 		// track_goal_road point parent of Goal Node
 		while (track_goal_road->p != start) {
@@ -307,11 +383,14 @@ Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal) {
 	else {
 		res.length = -1;
 	}
+	PROF_PHASE(track_ns, phase_t);
 
 	// free check map
+	PROF_START(phase_t);
 	for (int i = 0; i < row; i++)
 		delete[] searched_map[i];
 	delete[] searched_map;
+	PROF_PHASE(alloc_ns, phase_t);
 	
 	return res;
 }
@@ -363,6 +442,7 @@ bool findPossibleMoves(Map **map, CheckMap **searched_map, Node *cur_node, vecto
 	// add child nodes to vector<Node *> leaf_nodes
 	for (int i = 0; i < cur_node->child.size(); i++) {
 		leaf_nodes.push_back(&cur_node->child[i]);
+		PROF_COUNT(pushes);
 	}
 
 	return false;
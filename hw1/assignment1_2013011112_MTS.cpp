@@ -0,0 +1,334 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// goal result info -> goal point, length, moves from start
+typedef struct GoalResult {
+	GoalResult(int, int);
+
+	Point p;
+	int length;
+	string path;
+} GoalResult;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// map checking enum data
+typedef enum class CheckMap {
+	UNCHECKED = 0,
+	CHECKED = 1,
+	START = 2,
+	GOAL = 3
+} CheckMap;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+GoalResult::GoalResult(int row_, int col_)
+	: p(row_, col_), length(-1) {}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+int calcMulti(Map **, int, int, Point &, vector<Point> &, int, vector<GoalResult> &);
+
+// usage: ./MTS [K] -> K nearest goals, every goal when K is omitted or 0
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// number of nearest goals to find
+	int k = 0;
+	if (argc > 1) {
+		k = atoi(argv[1]);
+		if (k < 0) {
+			cerr << "K value error" << endl;
+			return -1;
+		}
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	Point start;
+	vector<Point> goal;
+	vector<GoalResult> result;
+	int time = 0;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// calc K nearest goals in one pass
+	time = calcMulti(map_info, row, col, start, goal, k, result);
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// goal table -> (row,col) length path, nearest goal first
+	for (uint i = 0; i < result.size(); i++) {
+		output_f << "(" << result[i].p.row << "," << result[i].p.col << ") ";
+		output_f << "length=" << result[i].length << " ";
+		output_f << "path=" << result[i].path << endl;
+	}
+
+	output_f << "time=" << time << endl;
+	// no result
+	if (result.size() == 0)
+		output_f << "no result" << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// calc roads to K nearest goals with one breadth-first search
+// keep expanding after a goal is reached and record its length and parent chain
+// return number of expanded cells
+int calcMulti(Map **map, int row, int col, Point &start, vector<Point> &goal, int k, vector<GoalResult> &result) {
+	int time = 0;
+	int cell_num = row * col;
+	int goal_num = static_cast<int>(goal.size());
+	if (k <= 0 || k > goal_num)
+		k = goal_num;
+
+	// flat search state -> check flag and parent cell index of every cell
+	vector<CheckMap> search_map(cell_num, CheckMap::UNCHECKED);
+	vector<int> parent(cell_num, -1);
+	vector<int> search_queue(cell_num);
+	int queue_head = 0;
+	int queue_tail = 0;
+
+	for (int i = 0; i < goal_num; i++)
+		search_map[goal[i].row * col + goal[i].col] = CheckMap::GOAL;
+
+	int start_idx = start.row * col + start.col;
+	search_map[start_idx] = CheckMap::START;
+	parent[start_idx] = start_idx;
+	search_queue[queue_tail++] = start_idx;
+
+	// goal cells in order of arrival -> nearest goal first
+	vector<int> found_goal;
+
+	// search until K goals are found
+	// search_queue is empty when the other goals cannot be reached
+	while (queue_head < queue_tail && static_cast<int>(found_goal.size()) < k) {
+		int cur_idx = search_queue[queue_head++];
+		int cur_row = cur_idx / col;
+		int cur_col = cur_idx % col;
+
+		time++;
+
+		// record goal and keep searching for the next one
+		// goal is expanded too -> goals behind it are reached through it
+		if (map[cur_row][cur_col] == Map::GOAL) {
+			found_goal.push_back(cur_idx);
+			if (static_cast<int>(found_goal.size()) >= k)
+				break;
+		}
+
+		// UP, RIGHT, DOWN, LEFT
+		int next_idx[4] = {-1, -1, -1, -1};
+		if (cur_row > 0)
+			next_idx[0] = cur_idx - col;
+		if (cur_col < col - 1)
+			next_idx[1] = cur_idx + 1;
+		if (cur_row < row - 1)
+			next_idx[2] = cur_idx + col;
+		if (cur_col > 0)
+			next_idx[3] = cur_idx - 1;
+
+		for (int d = 0; d < 4; d++) {
+			int n = next_idx[d];
+			if (n == -1)
+				continue;
+
+			Map cell = map[n / col][n % col];
+			if ((cell == Map::ROAD || cell == Map::GOAL) &&
+					(search_map[n] == CheckMap::UNCHECKED || search_map[n] == CheckMap::GOAL)) {
+				search_map[n] = CheckMap::CHECKED;
+				parent[n] = cur_idx;
+				search_queue[queue_tail++] = n;
+			}
+		}
+	}
+
+	// make result roads to start point from each goal
+	for (uint i = 0; i < found_goal.size(); i++) {
+		GoalResult goal_res(found_goal[i] / col, found_goal[i] % col);
+		goal_res.length = 0;
+
+		string reverse_path;
+		int cur_idx = found_goal[i];
+		while (cur_idx != start_idx) {
+			int prev_idx = parent[cur_idx];
+
+			// direction of the move prev -> cur
+			if (cur_idx == prev_idx - col)
+				reverse_path.push_back('U');
+			else if (cur_idx == prev_idx + 1)
+				reverse_path.push_back('R');
+			else if (cur_idx == prev_idx + col)
+				reverse_path.push_back('D');
+			else
+				reverse_path.push_back('L');
+
+			// goal cell itself is not a part of the length, other goals on the road keep their mark
+			if (cur_idx != found_goal[i]) {
+				if (map[cur_idx / col][cur_idx % col] == Map::ROAD)
+					map[cur_idx / col][cur_idx % col] = Map::ROAD_G;
+				goal_res.length++;
+			}
+
+			cur_idx = prev_idx;
+		}
+
+		goal_res.path.assign(reverse_path.rbegin(), reverse_path.rend());
+		result.push_back(goal_res);
+	}
+
+	return time;
+}
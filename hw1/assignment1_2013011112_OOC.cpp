@@ -0,0 +1,606 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <list>
+#include <queue>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// cell state bits in a tile -> direction from parent (2 bits), opened, closed
+#define STATE_DIR		0x03
+#define STATE_OPENED	0x04
+#define STATE_CLOSED	0x08
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell
+// cells are (row, col) pairs, row * col of out-of-core maps can exceed int
+typedef struct OpenNode {
+	OpenNode(int, int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int row;
+	int col;
+} OpenNode;
+
+// result info -> length, time
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+} Result;
+
+// tile of tile x tile cells -> map values, state bits and length from start of every cell
+// one record in the tile file, data = int32 lengths first (aligned for any tile size), then tile * tile bytes of map, same of state
+typedef struct Tile {
+	uint8_t *map();
+	uint8_t *state();
+	int32_t *length();
+
+	long long id;
+	bool dirty;
+	list<int>::iterator order_pos;
+	vector<uint8_t> data;
+} Tile;
+
+// LRU tile cache over the tile file with a memory budget
+// a slot is written back only when it is dirty and evicted, dirty tiles left at the end go with the temporary file
+// get returns NULL and sets io_error when the tile file cannot be read or written
+typedef struct TileCache {
+	TileCache(int, int, int, int, size_t);
+	Tile *get(int, int);
+	void prefetch(int, int);
+
+	int fd;
+	int tile;
+	int row;
+	int col;
+	int tile_col_num;
+	size_t tile_bytes;
+	int slot_num;
+	vector<Tile> slot;
+	list<int> order;
+	unordered_map<long long, int> resident;
+	unordered_set<long long> hinted;
+	Tile *last;
+	bool io_error;
+
+	long long hits;
+	long long misses;
+	long long prefetches;
+	long long bytes_read;
+	long long bytes_written;
+} TileCache;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int row_, int col_)
+	: score(score_), length_to_goal(length_to_goal_), row(row_), col(col_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+	if (row != n.row)
+		return row > n.row;
+
+	return col > n.col;
+}
+
+Result::Result()
+	: length(0), time(0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+
+	return *this;
+}
+
+uint8_t *Tile::map() {
+	return data.data() + data.size() / 6 * 4;
+}
+
+uint8_t *Tile::state() {
+	return data.data() + data.size() / 6 * 5;
+}
+
+int32_t *Tile::length() {
+	return reinterpret_cast<int32_t *>(data.data());
+}
+
+// at least 4 slots -> current tile and a neighbour tile always fit
+TileCache::TileCache(int fd_, int tile_, int row_, int col_, size_t budget)
+	: fd(fd_), tile(tile_), row(row_), col(col_), last(NULL), io_error(false),
+	  hits(0), misses(0), prefetches(0), bytes_read(0), bytes_written(0) {
+	tile_col_num = (col + tile - 1) / tile;
+	tile_bytes = static_cast<size_t>(tile) * tile * 6;
+	slot_num = max(4, static_cast<int>(budget / tile_bytes));
+
+	slot.resize(slot_num);
+	for (int i = 0; i < slot_num; i++) {
+		slot[i].id = -1;
+		slot[i].dirty = false;
+	}
+}
+
+// tile of cell (row, col), page in and evict least recently used tile on miss
+Tile *TileCache::get(int cell_row, int cell_col) {
+	long long id = static_cast<long long>(cell_row / tile) * tile_col_num + cell_col / tile;
+
+	// same tile as the last access -> no LRU update
+	if (last != NULL && last->id == id) {
+		hits++;
+		return last;
+	}
+
+	auto it = resident.find(id);
+	if (it != resident.end()) {
+		hits++;
+		order.splice(order.begin(), order, slot[it->second].order_pos);
+		last = &slot[it->second];
+		return last;
+	}
+
+	misses++;
+
+	// free slot first, then least recently used slot
+	int s = static_cast<int>(resident.size());
+	if (s >= slot_num) {
+		s = order.back();
+		order.pop_back();
+
+		Tile &victim = slot[s];
+		if (victim.dirty) {
+			if (pwrite(fd, victim.data.data(), tile_bytes, victim.id * tile_bytes) != static_cast<ssize_t>(tile_bytes)) {
+				io_error = true;
+				return NULL;
+			}
+
+			bytes_written += tile_bytes;
+		}
+		resident.erase(victim.id);
+		victim.id = -1;
+	}
+
+	Tile &t = slot[s];
+	t.data.resize(tile_bytes);
+	if (pread(fd, t.data.data(), tile_bytes, id * tile_bytes) != static_cast<ssize_t>(tile_bytes)) {
+		io_error = true;
+		return NULL;
+	}
+
+	bytes_read += tile_bytes;
+	t.id = id;
+	t.dirty = false;
+
+	resident[id] = s;
+	hinted.erase(id);
+	order.push_front(s);
+	t.order_pos = order.begin();
+	last = &t;
+
+	return last;
+}
+
+// ask the kernel to read tile of cell (row, col) ahead, skip resident and hinted tiles
+void TileCache::prefetch(int cell_row, int cell_col) {
+	if (cell_row < 0 || cell_row >= row || cell_col < 0 || cell_col >= col)
+		return;
+
+	long long id = static_cast<long long>(cell_row / tile) * tile_col_num + cell_col / tile;
+	if (resident.count(id) != 0 || !hinted.insert(id).second)
+		return;
+
+	posix_fadvise(fd, id * tile_bytes, tile_bytes, POSIX_FADV_WILLNEED);
+	prefetches++;
+}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+// UP, RIGHT, DOWN, LEFT
+const int DIR_ROW[4] = {-1, 0, 1, 0};
+const int DIR_COL[4] = {0, 1, 0, -1};
+
+Result calc(TileCache &, Point &, vector<Point> &, bool, unordered_set<long long> &);
+int shortestLength(int, int, vector<Point> &);
+
+// usage: ./OOC [astar|bfs] [budget_mb] [tile] -> A* (default) or BFS with map and search state in tiles on disk
+// input.txt is converted into tile file ooc_tiles.bin (removed after search), tiles are paged in through
+// an LRU tile cache of budget_mb (64 MB by default), tile x tile cells (64 by default) per tile
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+	string tile_filename = "ooc_tiles.bin";
+
+	// search mode, tile cache budget and tile size
+	bool astar = !(argc > 1 && strcmp(argv[1], "bfs") == 0);
+	long budget_mb = (argc > 2) ? atol(argv[2]) : 64;
+	int tile = (argc > 3) ? atoi(argv[3]) : 64;
+	if (budget_mb <= 0 || tile <= 0 || tile > 4096) {
+		cerr << "budget or tile value error" << endl;
+		return -1;
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// create tile file
+	int tile_fd = open(tile_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (tile_fd < 0) {
+		cerr << "tile file cannot be created" << endl;
+		return -1;
+	}
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt band by band -> only tile rows of the map are in memory
+	Point start;
+	vector<Point> goal;
+	Result result;
+	unordered_set<long long> road;
+	struct rusage usage;
+	TileCache *cache = NULL;
+	int tile_col_num = (col + tile - 1) / tile;
+	size_t tile_bytes = static_cast<size_t>(tile) * tile * 6;
+	size_t map_offset = static_cast<size_t>(tile) * tile * 4;
+	vector<uint8_t> band(tile_bytes * tile_col_num, 0);
+	for (long long i = 0; i < static_cast<long long>(row) * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+			case 2:
+				break;
+
+			// start point must exist only one
+			case 3:
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		// map value of tile cell, state and length start from 0
+		band[(col_j / tile) * tile_bytes + map_offset + (row_i % tile) * tile + col_j % tile] = static_cast<uint8_t>(map_1cell_data);
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+
+			// band is full -> write every tile of the band, cells out of map are WALL
+			if (row_i % tile == 0 || row_i == row) {
+				for (int t = 0; t < tile_col_num; t++) {
+					uint8_t *tile_data = band.data() + t * tile_bytes;
+					uint8_t *tile_map = tile_data + map_offset;
+					for (int r = 0; r < tile; r++)
+						for (int c = 0; c < tile; c++)
+							if ((row_i - 1) / tile * tile + r >= row || t * tile + c >= col)
+								tile_map[r * tile + c] = static_cast<uint8_t>(Map::WALL);
+
+					long long id = static_cast<long long>((row_i - 1) / tile) * tile_col_num + t;
+					if (pwrite(tile_fd, tile_data, tile_bytes, id * tile_bytes) != static_cast<ssize_t>(tile_bytes)) {
+						cerr << "tile file cannot be written" << endl;
+						goto RELEASE_DATA;
+					}
+				}
+
+				fill(band.begin(), band.end(), 0);
+			}
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	band.clear();
+	band.shrink_to_fit();
+
+	// calc best result through the tile cache
+	cache = new TileCache(tile_fd, tile, row, col, static_cast<size_t>(budget_mb) << 20);
+	result = calc(*cache, start, goal, astar, road);
+	if (cache->io_error) {
+		cerr << "tile file cannot be read or written" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// write -> stream input.txt again and mark road cells
+	input_f.clear();
+	input_f.seekg(0);
+	input_f >> row >> col;
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			input_f >> map_1cell_data;
+			if (road.count(static_cast<long long>(i) * col + j) != 0)
+				map_1cell_data = static_cast<int>(Map::ROAD_G);
+
+			output_f << map_1cell_data << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// best result
+	if (result.length != -1) {
+		output_f << "length=" << result.length << endl;
+		output_f << "time=" << result.time << endl;
+	}
+	// no result
+	else {
+		output_f << "time=" << result.time << endl;
+		output_f << "no result" << endl;
+	}
+
+	getrusage(RUSAGE_SELF, &usage);
+	output_f << "tile=" << tile << endl;
+	output_f << "tile_slots=" << cache->slot_num << endl;
+	output_f << "tile_hits=" << cache->hits << endl;
+	output_f << "tile_misses=" << cache->misses << endl;
+	output_f << "hit_rate=" << static_cast<double>(cache->hits) / max(1LL, cache->hits + cache->misses) << endl;
+	output_f << "prefetches=" << cache->prefetches << endl;
+	output_f << "read_mb=" << cache->bytes_read / 1048576.0 << endl;
+	output_f << "write_mb=" << cache->bytes_written / 1048576.0 << endl;
+	output_f << "peak_rss_kb=" << usage.ru_maxrss << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	delete cache;
+	close(tile_fd);
+	unlink(tile_filename.c_str());
+
+	return 0;
+}
+
+// calc result road using A* (or BFS with length to goal 0) over the tile cache
+// open list is in memory with lazy deletion, length and parent of every cell live in tiles
+// when the search moves close to a tile border, the next tile in that direction is prefetched
+// stops at the first tile file error, cache.io_error tells it apart from no result
+Result calc(TileCache &cache, Point &start, vector<Point> &goal, bool astar, unordered_set<long long> &road) {
+	Result res;
+	int row = cache.row;
+	int col = cache.col;
+	int tile = cache.tile;
+	int prefetch_distance = max(1, tile / 8);
+
+	priority_queue<OpenNode, vector<OpenNode>, greater<OpenNode> > search_queue;
+	{
+		Tile *t = cache.get(start.row, start.col);
+		if (t == NULL)
+			return res;
+
+		int i = (start.row % tile) * tile + start.col % tile;
+		t->state()[i] = STATE_OPENED;
+		t->length()[i] = 0;
+		t->dirty = true;
+	}
+	search_queue.push(OpenNode(0, 0, start.row, start.col));
+
+	Point goal_p;
+
+	// search continuously until finding result
+	// search_queue is empty when there is no result
+	while (!search_queue.empty()) {
+		OpenNode node = search_queue.top();
+		search_queue.pop();
+
+		Tile *t = cache.get(node.row, node.col);
+		if (t == NULL)
+			return res;
+
+		int i = (node.row % tile) * tile + node.col % tile;
+
+		// skip stale node -> cell was closed or got shorter length after the push
+		if ((t->state()[i] & STATE_CLOSED) || node.score != t->length()[i] + node.length_to_goal)
+			continue;
+
+		res.time++;
+
+		// check if goal node
+		if (t->map()[i] == static_cast<uint8_t>(Map::GOAL)) {
+			goal_p = Point(node.row, node.col);
+			break;
+		}
+
+		t->state()[i] |= STATE_CLOSED;
+		t->dirty = true;
+
+		// prefetch along the direction the frontier came from parent
+		int cur_length = t->length()[i];
+		if (cur_length > 0) {
+			int d = t->state()[i] & STATE_DIR;
+			cache.prefetch(node.row + DIR_ROW[d] * prefetch_distance, node.col + DIR_COL[d] * prefetch_distance);
+		}
+
+		for (int d = 0; d < 4; d++) {
+			int next_row = node.row + DIR_ROW[d];
+			int next_col = node.col + DIR_COL[d];
+			if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+				continue;
+
+			Tile *n = cache.get(next_row, next_col);
+			if (n == NULL)
+				return res;
+
+			int j = (next_row % tile) * tile + next_col % tile;
+			uint8_t next_cell = n->map()[j];
+			if (next_cell != static_cast<uint8_t>(Map::ROAD) && next_cell != static_cast<uint8_t>(Map::GOAL))
+				continue;
+			if ((n->state()[j] & STATE_CLOSED) || ((n->state()[j] & STATE_OPENED) && n->length()[j] <= cur_length + 1))
+				continue;
+
+			n->state()[j] = STATE_OPENED | d;
+			n->length()[j] = cur_length + 1;
+			n->dirty = true;
+
+			int length_to_goal = astar ? shortestLength(next_row, next_col, goal) : 0;
+			search_queue.push(OpenNode(cur_length + 1 + length_to_goal, length_to_goal, next_row, next_col));
+		}
+	}
+
+	// make result road to start point from goal
+	if (goal_p.row != -1) {
+		Tile *t = cache.get(goal_p.row, goal_p.col);
+		if (t == NULL)
+			return res;
+
+		res.length = t->length()[(goal_p.row % tile) * tile + goal_p.col % tile] - 1;
+
+		Point track_road = goal_p;
+		while (true) {
+			t = cache.get(track_road.row, track_road.col);
+			if (t == NULL)
+				return res;
+
+			int d = t->state()[(track_road.row % tile) * tile + track_road.col % tile] & STATE_DIR;
+			track_road.row -= DIR_ROW[d];
+			track_road.col -= DIR_COL[d];
+			if (track_road == start)
+				break;
+
+			road.insert(static_cast<long long>(track_road.row) * col + track_road.col);
+		}
+	}
+	// no result
+	else
+		res.length = -1;
+
+	return res;
+}
+
+// calc shortest length to several goals
+int shortestLength(int row, int col, vector<Point> &goal) {
+	int length = INT_MAX;
+
+	Point cur_p(row, col);
+	for (uint i = 0; i < goal.size(); i++) {
+		int curLength = DISTANCE(cur_p, goal[i]);
+
+		if (length > curLength)
+			length = curLength;
+	}
+
+	return length;
+}
@@ -0,0 +1,860 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <unordered_map>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// quadtree node type -> uniform WALL square, uniform free square, or split into 4 children
+#define QUAD_WALL	0
+#define QUAD_FREE	1
+#define QUAD_MIXED	2
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell index (leaf index in leaf open list)
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+} OpenNode;
+
+// result info -> length, time (expanded leaves)
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+} Result;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// quadtree node -> square (row, col) ~ (row + size - 1, col + size - 1), type, first of 4 children
+// children are stored next to each other -> top-left, top-right, bottom-left, bottom-right, -1 for leaf
+typedef struct QuadNode {
+	QuadNode(int, int, int);
+
+	int row;
+	int col;
+	int size;
+	uint8_t type;
+	int child;
+} QuadNode;
+
+// border segment of a free leaf shared with a free neighbour leaf
+// -> neighbour leaf, side (UP, RIGHT, DOWN, LEFT), first and last col (UP, DOWN) or row (RIGHT, LEFT) of the segment
+typedef struct QuadLink {
+	QuadLink(int, int, int, int);
+
+	int leaf;
+	int side;
+	int begin;
+	int end;
+} QuadLink;
+
+// region quadtree over the map padded to a power of 2 size, cells out of map are WALL
+// every uniform square is one leaf, so big open regions are a handful of nodes
+// links of leaf idx are link[link_begin[idx]] ~ link[link_begin[idx + 1] - 1], made after build or load
+typedef struct QuadTree {
+	QuadTree();
+	void build(Map **, int, int);
+	uint8_t buildNode(Map **, int);
+	bool save(const string &, uint64_t) const;
+	void saveNode(vector<uint8_t> &, int) const;
+	bool load(const string &, int, int, uint64_t);
+	bool loadNode(const vector<uint8_t> &, size_t &, int);
+	int leafOf(int, int) const;
+	void buildLink();
+	void linkNode(vector<int> &, bool, int);
+	void linkPair(vector<int> &, bool, int, int, bool);
+
+	int row;
+	int col;
+	int size;
+	vector<QuadNode> node;
+	vector<QuadLink> link;
+	vector<int> link_begin;
+	int leaf_num;
+	int free_leaf_num;
+} QuadTree;
+
+// quadtree file header, followed by
+//   uint8 type[node_num] -> node types in pre-order, 4 children follow every QUAD_MIXED node
+typedef struct QtsHeader {
+	char magic[4];
+	int32_t row;
+	int32_t col;
+	int32_t node_num;
+	uint64_t version;
+} QtsHeader;
+
+// search label of a perimeter cell -> length from start, previous waypoint, leaf expansion that set the length
+// waypoint is a neighbour cell of another leaf, or an entry cell of the same free leaf
+typedef struct Label {
+	Label();
+
+	int length;
+	int parent;
+	int expansion;
+} Label;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+Result::Result()
+	: length(0), time(0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+
+	return *this;
+}
+
+QuadNode::QuadNode(int row_, int col_, int size_)
+	: row(row_), col(col_), size(size_), type(QUAD_WALL), child(-1) {}
+
+QuadLink::QuadLink(int leaf_, int side_, int begin_, int end_)
+	: leaf(leaf_), side(side_), begin(begin_), end(end_) {}
+
+QuadTree::QuadTree()
+	: row(0), col(0), size(1), leaf_num(0), free_leaf_num(0) {}
+
+Label::Label()
+	: length(INT_MAX), parent(-1), expansion(-1) {}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+// UP, RIGHT, DOWN, LEFT
+const int DIR_ROW[4] = {-1, 0, 1, 0};
+const int DIR_COL[4] = {0, 1, 0, -1};
+
+Result calc(Map **, int, int, Point &, vector<Point> &, QuadTree &);
+void sideLength(int, bool, int, int, const vector<int> &, const vector<int> &, int, vector<int> &, vector<int> &);
+uint64_t mapVersion(Map **, int, int);
+uint64_t cellHash(uint64_t);
+int shortestLength(int, int, vector<Point> &);
+
+// usage: ./QTS [quadtree_file] -> A* over free quadtree leaves of input.txt map
+// quadtree is loaded from quadtree_file (input.qt by default) when it was saved for the same WALL cells,
+// otherwise it is built and saved there, starts and goals can change between runs
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+	string quadtree_filename = (argc > 1) ? argv[1] : "input.qt";
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	Point start;
+	vector<Point> goal;
+	Result result;
+	QuadTree tree;
+	bool loaded = false;
+	uint64_t version = 0;
+	double preprocess_ms = 0.0;
+	double search_ms = 0.0;
+	chrono::steady_clock::time_point begin;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// load saved quadtree or build and save it
+	begin = chrono::steady_clock::now();
+	version = mapVersion(map_info, row, col);
+	loaded = tree.load(quadtree_filename, row, col, version);
+	if (!loaded) {
+		tree.build(map_info, row, col);
+		if (!tree.save(quadtree_filename, version))
+			cerr << "quadtree file cannot be written" << endl;
+	}
+	preprocess_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+	// calc best result
+	begin = chrono::steady_clock::now();
+	result = calc(map_info, row, col, start, goal, tree);
+	search_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// best result
+	if (result.length != -1) {
+		output_f << "length=" << result.length << endl;
+		output_f << "time=" << result.time << endl;
+	}
+	// no result
+	else {
+		output_f << "time=" << result.time << endl;
+		output_f << "no result" << endl;
+	}
+
+	output_f << "quadtree=" << (loaded ? "loaded" : "built") << endl;
+	output_f << "quad_nodes=" << tree.node.size() << endl;
+	output_f << "leaves=" << tree.leaf_num << endl;
+	output_f << "free_leaves=" << tree.free_leaf_num << endl;
+	output_f << "links=" << tree.link.size() << endl;
+	output_f << "preprocess_ms=" << preprocess_ms << endl;
+	output_f << "search_ms=" << search_ms << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// build quadtree of map -> root covers the smallest power of 2 square over the map
+void QuadTree::build(Map **map, int row_, int col_) {
+	row = row_;
+	col = col_;
+	size = 1;
+	while (size < row || size < col)
+		size *= 2;
+
+	node.clear();
+	node.emplace_back(0, 0, size);
+	buildNode(map, 0);
+
+	leaf_num = 0;
+	free_leaf_num = 0;
+	for (uint i = 0; i < node.size(); i++) {
+		if (node[i].child == -1) {
+			leaf_num++;
+			free_leaf_num += (node[i].type == QUAD_FREE);
+		}
+	}
+
+	buildLink();
+}
+
+// build subtree of node idx, return its type
+// children of a node are appended last, so 4 uniform leaves of the same type are merged by popping them
+uint8_t QuadTree::buildNode(Map **map, int idx) {
+	int node_row = node[idx].row;
+	int node_col = node[idx].col;
+	int node_size = node[idx].size;
+
+	// square out of map -> WALL leaf
+	if (node_row >= row || node_col >= col) {
+		node[idx].type = QUAD_WALL;
+		return QUAD_WALL;
+	}
+
+	if (node_size == 1) {
+		node[idx].type = (map[node_row][node_col] == Map::WALL) ? QUAD_WALL : QUAD_FREE;
+		return node[idx].type;
+	}
+
+	int half = node_size / 2;
+	int child = static_cast<int>(node.size());
+	node[idx].child = child;
+	for (int k = 0; k < 4; k++)
+		node.emplace_back(node_row + (k / 2) * half, node_col + (k % 2) * half, half);
+
+	uint8_t child_type[4];
+	for (int k = 0; k < 4; k++)
+		child_type[k] = buildNode(map, child + k);
+
+	if (child_type[0] != QUAD_MIXED && child_type[0] == child_type[1] &&
+			child_type[0] == child_type[2] && child_type[0] == child_type[3]) {
+		node.erase(node.begin() + child, node.end());
+		node[idx].child = -1;
+		node[idx].type = child_type[0];
+	}
+	else
+		node[idx].type = QUAD_MIXED;
+
+	return node[idx].type;
+}
+
+// write header and node types in pre-order
+bool QuadTree::save(const string &filename, uint64_t version) const {
+	QtsHeader header;
+	memcpy(header.magic, "QTS1", 4);
+	header.row = row;
+	header.col = col;
+	header.node_num = static_cast<int32_t>(node.size());
+	header.version = version;
+
+	vector<uint8_t> type;
+	type.reserve(node.size());
+	saveNode(type, 0);
+
+	ofstream quadtree_f(filename, ios::binary);
+	if (!quadtree_f.is_open())
+		return false;
+
+	quadtree_f.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	quadtree_f.write(reinterpret_cast<const char *>(type.data()), type.size());
+
+	return quadtree_f.good();
+}
+
+void QuadTree::saveNode(vector<uint8_t> &type, int idx) const {
+	type.push_back(node[idx].type);
+	if (node[idx].child != -1)
+		for (int k = 0; k < 4; k++)
+			saveNode(type, node[idx].child + k);
+}
+
+// read quadtree saved for a map of the same size and WALL cells, false when there is none
+bool QuadTree::load(const string &filename, int row_, int col_, uint64_t version) {
+	ifstream quadtree_f(filename, ios::binary);
+	if (!quadtree_f.is_open())
+		return false;
+
+	QtsHeader header;
+	quadtree_f.read(reinterpret_cast<char *>(&header), sizeof(header));
+	if (!quadtree_f.good() || memcmp(header.magic, "QTS1", 4) != 0 ||
+			header.row != row_ || header.col != col_ || header.version != version || header.node_num <= 0)
+		return false;
+
+	vector<uint8_t> type(header.node_num);
+	quadtree_f.read(reinterpret_cast<char *>(type.data()), type.size());
+	if (!quadtree_f.good())
+		return false;
+
+	row = row_;
+	col = col_;
+	size = 1;
+	while (size < row || size < col)
+		size *= 2;
+
+	node.clear();
+	node.reserve(header.node_num);
+	node.emplace_back(0, 0, size);
+
+	size_t pos = 0;
+	if (!loadNode(type, pos, 0) || pos != type.size()) {
+		node.clear();
+		return false;
+	}
+
+	leaf_num = 0;
+	free_leaf_num = 0;
+	for (uint i = 0; i < node.size(); i++) {
+		if (node[i].child == -1) {
+			leaf_num++;
+			free_leaf_num += (node[i].type == QUAD_FREE);
+		}
+	}
+
+	buildLink();
+
+	return true;
+}
+
+// rebuild node idx from type at pos, same child layout as build
+bool QuadTree::loadNode(const vector<uint8_t> &type, size_t &pos, int idx) {
+	if (pos >= type.size() || type[pos] > QUAD_MIXED)
+		return false;
+
+	node[idx].type = type[pos++];
+	if (node[idx].type != QUAD_MIXED)
+		return true;
+	if (node[idx].size == 1)
+		return false;
+
+	int half = node[idx].size / 2;
+	int child = static_cast<int>(node.size());
+	node[idx].child = child;
+	for (int k = 0; k < 4; k++)
+		node.emplace_back(node[idx].row + (k / 2) * half, node[idx].col + (k % 2) * half, half);
+
+	for (int k = 0; k < 4; k++)
+		if (!loadNode(type, pos, child + k))
+			return false;
+
+	return true;
+}
+
+// leaf containing cell (cell_row, cell_col)
+int QuadTree::leafOf(int cell_row, int cell_col) const {
+	int idx = 0;
+	while (node[idx].child != -1) {
+		int half = node[idx].size / 2;
+		idx = node[idx].child + (cell_row >= node[idx].row + half) * 2 + (cell_col >= node[idx].col + half);
+	}
+
+	return idx;
+}
+
+// border segments of every free leaf shared with free neighbour leaves, grouped by leaf
+// first walk counts links of every leaf, second walk writes them in place
+void QuadTree::buildLink() {
+	vector<int> pos(node.size(), 0);
+	linkNode(pos, false, 0);
+
+	link_begin.assign(node.size() + 1, 0);
+	for (uint i = 0; i < node.size(); i++)
+		link_begin[i + 1] = link_begin[i] + pos[i];
+
+	pos.assign(link_begin.begin(), link_begin.end() - 1);
+	link.assign(link_begin[node.size()], QuadLink(-1, 0, 0, 0));
+	linkNode(pos, true, 0);
+}
+
+// links inside subtree of node idx -> links inside every child, then links across the 4 inner sides
+void QuadTree::linkNode(vector<int> &pos, bool fill, int idx) {
+	int child = node[idx].child;
+	if (child == -1)
+		return;
+
+	for (int k = 0; k < 4; k++)
+		linkNode(pos, fill, child + k);
+
+	linkPair(pos, fill, child, child + 1, true);
+	linkPair(pos, fill, child + 2, child + 3, true);
+	linkPair(pos, fill, child, child + 2, false);
+	linkPair(pos, fill, child + 1, child + 3, false);
+}
+
+// links across the shared side of subtrees a and b -> b is right of a when horizontal, below a otherwise
+// only children along the shared side are walked, so every link costs a few steps
+// pos is link count of every leaf, or next link slot of every leaf when fill
+void QuadTree::linkPair(vector<int> &pos, bool fill, int a, int b, bool horizontal) {
+	int a_child = node[a].child;
+	int b_child = node[b].child;
+	if (a_child == -1 && b_child == -1) {
+		if (node[a].type != QUAD_FREE || node[b].type != QUAD_FREE)
+			return;
+
+		if (!fill) {
+			pos[a]++;
+			pos[b]++;
+			return;
+		}
+
+		// shared rows when horizontal, shared cols otherwise
+		const QuadNode &p = node[a];
+		const QuadNode &q = node[b];
+		int begin = horizontal ? max(p.row, q.row) : max(p.col, q.col);
+		int end = horizontal ? min(p.row + p.size, q.row + q.size) - 1 : min(p.col + p.size, q.col + q.size) - 1;
+		link[pos[a]++] = QuadLink(b, horizontal ? 1 : 2, begin, end);
+		link[pos[b]++] = QuadLink(a, horizontal ? 3 : 0, begin, end);
+		return;
+	}
+
+	// right (or bottom) children of a against left (or top) children of b, a leaf stays itself
+	for (int k = 0; k < 2; k++) {
+		int a_next = (a_child == -1) ? a : a_child + (horizontal ? 1 + 2 * k : 2 + k);
+		int b_next = (b_child == -1) ? b : b_child + (horizontal ? 2 * k : k);
+		linkPair(pos, fill, a_next, b_next, horizontal);
+	}
+}
+
+// calc result road using A* over free quadtree leaves
+// a free leaf is an empty square, so length between two of its cells is their manhattan distance
+// labels are kept only for perimeter cells (and start, goals), a leaf is opened with the perimeter cells
+// entered from outside since its last expansion and its score is the best score of them
+// expanding a leaf fixes up length of its goals and of its cells on links from those entries at once
+// and opens the linked neighbour leaves, leaves are opened again whenever a shorter length arrives
+Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal, QuadTree &tree) {
+	Result res;
+
+	unordered_map<int, Label> label;
+	unordered_map<int, vector<int> > entry;
+	unordered_map<int, vector<int> > goal_of_leaf;
+	vector<int> leaf_score(tree.node.size(), INT_MAX);
+	priority_queue<OpenNode, vector<OpenNode>, greater<OpenNode> > search_queue;
+
+	for (uint i = 0; i < goal.size(); i++)
+		goal_of_leaf[tree.leafOf(goal[i].row, goal[i].col)].push_back(goal[i].row * col + goal[i].col);
+
+	// start leaf is entered at start cell
+	int start_idx = start.row * col + start.col;
+	int start_leaf = tree.leafOf(start.row, start.col);
+	int start_length_to_goal = shortestLength(start.row, start.col, goal);
+	label[start_idx].length = 0;
+	label[start_idx].parent = start_idx;
+	entry[start_leaf].push_back(start_idx);
+	leaf_score[start_leaf] = start_length_to_goal;
+	search_queue.push(OpenNode(start_length_to_goal, start_length_to_goal, start_leaf));
+
+	int goal_idx = -1;
+	int best_length = INT_MAX;
+
+	// side sweep buffers of the expanded leaf, reused by every expansion
+	vector<int> side_length[4];
+	vector<int> side_parent[4];
+
+	// search until no open leaf can beat the best goal
+	while (!search_queue.empty()) {
+		OpenNode top = search_queue.top();
+		if (top.score >= best_length)
+			break;
+
+		search_queue.pop();
+		int leaf = top.cell;
+		if (top.score != leaf_score[leaf])
+			continue;
+
+		leaf_score[leaf] = INT_MAX;
+		vector<int> leaf_entry;
+		leaf_entry.swap(entry[leaf]);
+		entry.erase(leaf);
+		sort(leaf_entry.begin(), leaf_entry.end());
+		leaf_entry.erase(unique(leaf_entry.begin(), leaf_entry.end()), leaf_entry.end());
+
+		res.time++;
+
+		const QuadNode &q = tree.node[leaf];
+		int row0 = q.row;
+		int col0 = q.col;
+		int row1 = min(q.row + q.size, row) - 1;
+		int col1 = min(q.col + q.size, col) - 1;
+
+		// length from start of entries -> fixed while the leaf is expanded
+		vector<int> entry_length(leaf_entry.size());
+		for (uint e = 0; e < leaf_entry.size(); e++)
+			entry_length[e] = label[leaf_entry[e]].length;
+
+		// goals in leaf
+		auto goal_it = goal_of_leaf.find(leaf);
+		if (goal_it != goal_of_leaf.end()) {
+			for (uint i = 0; i < goal_it->second.size(); i++) {
+				int cell = goal_it->second[i];
+				Label &l = label[cell];
+				for (uint e = 0; e < leaf_entry.size(); e++) {
+					int length = entry_length[e] + abs(cell / col - leaf_entry[e] / col) + abs(cell % col - leaf_entry[e] % col);
+					if (length < l.length) {
+						l.length = length;
+						l.parent = leaf_entry[e];
+					}
+				}
+
+				if (l.length < best_length) {
+					best_length = l.length;
+					goal_idx = cell;
+				}
+			}
+		}
+
+		// cells on links of every side -> length from the side sweep, link neighbour across the side
+		bool side_done[4] = {false, false, false, false};
+		for (int k = tree.link_begin[leaf]; k < tree.link_begin[leaf + 1]; k++) {
+			const QuadLink &link = tree.link[k];
+			int d = link.side;
+			bool along_col = (d % 2 == 0);
+			int fixed = (d == 0) ? row0 : (d == 1) ? col1 : (d == 2) ? row1 : col0;
+			int lo = along_col ? col0 : row0;
+			if (!side_done[d]) {
+				side_done[d] = true;
+				sideLength(fixed, along_col, lo, along_col ? col1 : row1, leaf_entry, entry_length, col, side_length[d], side_parent[d]);
+			}
+
+			for (int p = link.begin; p <= link.end; p++) {
+				int cell_row = along_col ? fixed : p;
+				int cell_col = along_col ? p : fixed;
+				int cell = cell_row * col + cell_col;
+				int length = side_length[d][p - lo];
+
+				// cell is sent to neighbour leaves when it is an entry or gets a shorter length in this expansion
+				// (corner cells are on two sides), otherwise its length was already sent by an earlier expansion
+				Label &l = label[cell];
+				if (length < l.length) {
+					l.length = length;
+					l.parent = side_parent[d][p - lo];
+					l.expansion = res.time;
+				}
+				else if (l.expansion == res.time || binary_search(leaf_entry.begin(), leaf_entry.end(), cell))
+					length = l.length;
+				else
+					continue;
+
+				int next_row = cell_row + DIR_ROW[d];
+				int next_col = cell_col + DIR_COL[d];
+				int next_idx = next_row * col + next_col;
+				if (next_idx == start_idx)
+					continue;
+
+				int next_length_to_goal = shortestLength(next_row, next_col, goal);
+				int next_score = length + 1 + next_length_to_goal;
+				if (next_score >= best_length)
+					continue;
+
+				Label &next_l = label[next_idx];
+				if (length + 1 >= next_l.length)
+					continue;
+
+				next_l.length = length + 1;
+				next_l.parent = cell;
+
+				entry[link.leaf].push_back(next_idx);
+				if (next_score < leaf_score[link.leaf]) {
+					leaf_score[link.leaf] = next_score;
+					search_queue.push(OpenNode(next_score, next_length_to_goal, link.leaf));
+				}
+			}
+		}
+	}
+
+	// make result road to start point from goal
+	// waypoints of the same leaf are joined along row first, then col, inside the empty square
+	if (goal_idx != -1) {
+		int cur = goal_idx;
+		while (cur != start_idx) {
+			int waypoint = label[cur].parent;
+			int walk_row = cur / col;
+			int walk_col = cur % col;
+			while (walk_row * col + walk_col != waypoint) {
+				if (walk_col != waypoint % col)
+					walk_col += (waypoint % col > walk_col) ? 1 : -1;
+				else
+					walk_row += (waypoint / col > walk_row) ? 1 : -1;
+
+				if (walk_row * col + walk_col != start_idx) {
+					map[walk_row][walk_col] = Map::ROAD_G;
+					res.length++;
+				}
+			}
+
+			cur = waypoint;
+		}
+	}
+	// no result
+	else
+		res.length = -1;
+
+	return res;
+}
+
+// shortest length through entries of every side cell of a free leaf, parent is the entry it comes from
+// side cells are (fixed, lo ~ hi) when along_col, otherwise (lo ~ hi, fixed)
+// entries are projected onto the side, then two sweeps along it -> side + entries steps instead of side * entries
+void sideLength(int fixed, bool along_col, int lo, int hi, const vector<int> &leaf_entry, const vector<int> &entry_length,
+		int col, vector<int> &length, vector<int> &parent) {
+	int side_num = hi - lo + 1;
+	length.assign(side_num, INT_MAX);
+	parent.assign(side_num, -1);
+	for (uint e = 0; e < leaf_entry.size(); e++) {
+		int entry_row = leaf_entry[e] / col;
+		int entry_col = leaf_entry[e] % col;
+		int p = (along_col ? entry_col : entry_row) - lo;
+		int projected = entry_length[e] + abs(fixed - (along_col ? entry_row : entry_col));
+		if (projected < length[p]) {
+			length[p] = projected;
+			parent[p] = leaf_entry[e];
+		}
+	}
+
+	for (int p = 1; p < side_num; p++) {
+		if (length[p - 1] != INT_MAX && length[p - 1] + 1 < length[p]) {
+			length[p] = length[p - 1] + 1;
+			parent[p] = parent[p - 1];
+		}
+	}
+	for (int p = side_num - 2; p >= 0; p--) {
+		if (length[p + 1] != INT_MAX && length[p + 1] + 1 < length[p]) {
+			length[p] = length[p + 1] + 1;
+			parent[p] = parent[p + 1];
+		}
+	}
+}
+
+// version of WALL cells -> xor of every cell hash
+uint64_t mapVersion(Map **map, int row, int col) {
+	uint64_t version = cellHash((static_cast<uint64_t>(row) << 32) | static_cast<uint64_t>(col));
+	for (int i = 0; i < row; i++)
+		for (int j = 0; j < col; j++)
+			version ^= cellHash((static_cast<uint64_t>(i * col + j) << 1) | (map[i][j] == Map::WALL));
+
+	return version;
+}
+
+// mix 64-bit value (splitmix64 finalizer)
+uint64_t cellHash(uint64_t k) {
+	k += 0x9E3779B97F4A7C15ULL;
+	k = (k ^ (k >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	k = (k ^ (k >> 27)) * 0x94D049BB133111EBULL;
+
+	return k ^ (k >> 31);
+}
+
+// calc shortest length to several goals
+int shortestLength(int row, int col, vector<Point> &goal) {
+	int length = INT_MAX;
+
+	Point cur_p(row, col);
+	for (uint i = 0; i < goal.size(); i++) {
+		int curLength = DISTANCE(cur_p, goal[i]);
+
+		if (length > curLength)
+			length = curLength;
+	}
+
+	return length;
+}
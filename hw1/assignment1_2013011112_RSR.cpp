@@ -0,0 +1,626 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell index
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+} OpenNode;
+
+// open list -> indexed 4-ary min heap of open nodes
+// pos keeps heap position of every cell (-1 -> not in heap) for decrease-key
+typedef struct OpenHeap {
+	OpenHeap(int);
+	bool empty() const;
+	int size() const;
+	bool contains(int) const;
+	const OpenNode &top() const;
+	const OpenNode &at(int) const;
+	void push(const OpenNode &);
+	void pop();
+	void decreaseKey(int, int);
+	void siftUp(int);
+	void siftDown(int);
+
+	vector<OpenNode> heap;
+	vector<int> pos;
+} OpenHeap;
+
+// result info -> length, time
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+} Result;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// empty rectangle info -> (row0, col0) ~ (row1, col1) inclusive
+typedef struct Rect {
+	Rect(int, int, int, int);
+
+	int row0;
+	int col0;
+	int row1;
+	int col1;
+} Rect;
+
+// search engine over reduced graph
+typedef enum class Engine {
+	ASTAR = 0,
+	GBS = 1,
+	BFS = 2
+} Engine;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+// heap size is bounded by cell_num
+OpenHeap::OpenHeap(int cell_num)
+	: pos(cell_num, -1) {}
+
+bool OpenHeap::empty() const {
+	return heap.empty();
+}
+
+int OpenHeap::size() const {
+	return static_cast<int>(heap.size());
+}
+
+bool OpenHeap::contains(int cell) const {
+	return pos[cell] != -1;
+}
+
+const OpenNode &OpenHeap::top() const {
+	return heap[0];
+}
+
+const OpenNode &OpenHeap::at(int cell) const {
+	return heap[pos[cell]];
+}
+
+void OpenHeap::push(const OpenNode &node) {
+	heap.push_back(node);
+	siftUp(size() - 1);
+}
+
+void OpenHeap::pop() {
+	pos[heap[0].cell] = -1;
+
+	OpenNode last = heap.back();
+	heap.pop_back();
+	if (!heap.empty()) {
+		heap[0] = last;
+		siftDown(0);
+	}
+}
+
+// set smaller score of cell in heap
+void OpenHeap::decreaseKey(int cell, int score) {
+	int i = pos[cell];
+	heap[i].score = score;
+	siftUp(i);
+}
+
+void OpenHeap::siftUp(int i) {
+	OpenNode node = heap[i];
+
+	while (i > 0) {
+		int parent = (i - 1) / 4;
+		if (!(heap[parent] > node))
+			break;
+
+		heap[i] = heap[parent];
+		pos[heap[i].cell] = i;
+		i = parent;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+void OpenHeap::siftDown(int i) {
+	OpenNode node = heap[i];
+	int n = size();
+
+	while (true) {
+		int first_child = 4 * i + 1;
+		if (first_child >= n)
+			break;
+
+		// smallest of up to 4 children
+		int best = first_child;
+		int last_child = min(first_child + 4, n);
+		for (int c = first_child + 1; c < last_child; c++)
+			if (heap[best] > heap[c])
+				best = c;
+
+		if (!(node > heap[best]))
+			break;
+
+		heap[i] = heap[best];
+		pos[heap[i].cell] = i;
+		i = best;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+Result::Result()
+	: length(0), time(0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+
+	return *this;
+}
+
+Rect::Rect(int row0_, int col0_, int row1_, int col1_)
+	: row0(row0_), col0(col0_), row1(row1_), col1(col1_) {}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+const char *ENGINE_NAME[] = {"astar", "gbs", "bfs"};
+
+Result calc(Map **, int, int, Point &, vector<Point> &, Engine);
+void decomposeRect(Map **, int, int, vector<Rect> &, vector<int> &);
+int findMacroMoves(Map **, const vector<Rect> &, const vector<int> &, int, int, int, int *, int *);
+int shortestLength(int, int, vector<Point> &);
+
+int RECT_NUM = 0;
+int PRUNED_NUM = 0;
+
+// usage: ./RSR [astar|gbs|bfs] -> search reduced graph with the engine (astar by default)
+// bfs runs uniform-cost search because macro edges have different lengths
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// engine option
+	int engine_i = 0;
+	if (argc > 1) {
+		while (engine_i < 3 && strcmp(ENGINE_NAME[engine_i], argv[1]) != 0)
+			engine_i++;
+		if (engine_i == 3) {
+			cerr << "unknown engine " << argv[1] << endl;
+			return -1;
+		}
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	Point start;
+	vector<Point> goal;
+	Result result;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// calc best result
+	result = calc(map_info, row, col, start, goal, static_cast<Engine>(engine_i));
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// best result
+	if (result.length != -1) {
+		output_f << "length=" << result.length << endl;
+		output_f << "time=" << result.time << endl;
+	}
+	// no result
+	else {
+		output_f << "time=" << result.time << endl;
+		output_f << "no result" << endl;
+	}
+
+	output_f << "rectangles=" << RECT_NUM << endl;
+	output_f << "pruned=" << PRUNED_NUM << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// calc result road over rectangular symmetry reduced graph
+// nodes -> start, goals and perimeter cells of empty rectangles, interior cells are pruned
+Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal, Engine engine) {
+	Result res;
+	int cell_num = row * col;
+
+	// decompose ROAD cells into empty rectangles
+	vector<Rect> rect;
+	vector<int> rect_id;
+	decomposeRect(map, row, col, rect, rect_id);
+
+	RECT_NUM = static_cast<int>(rect.size());
+	for (uint i = 0; i < rect.size(); i++) {
+		int height = rect[i].row1 - rect[i].row0 + 1;
+		int width = rect[i].col1 - rect[i].col0 + 1;
+		if (height > 2 && width > 2)
+			PRUNED_NUM += (height - 2) * (width - 2);
+	}
+
+	// per-cell length from start, parent cell index and closed flag
+	vector<int> length_from_start(cell_num, 0);
+	vector<int> parent(cell_num, -1);
+	vector<uint8_t> closed(cell_num, 0);
+
+	int start_idx = start.row * col + start.col;
+	parent[start_idx] = start_idx;
+
+	OpenHeap search_queue(cell_num);
+	search_queue.push(OpenNode(0, 0, start_idx));
+	int goal_idx = -1;
+
+	// search continuously until finding result
+	// search_queue is empty when there is no result
+	while (!search_queue.empty()) {
+		int cur_idx = search_queue.top().cell;
+		search_queue.pop();
+
+		res.time++;
+
+		// check if goal node
+		if (map[cur_idx / col][cur_idx % col] == Map::GOAL) {
+			goal_idx = cur_idx;
+			break;
+		}
+
+		closed[cur_idx] = 1;
+
+		int next_idx[8];
+		int next_cost[8];
+		int move_num = findMacroMoves(map, rect, rect_id, row, col, cur_idx, next_idx, next_cost);
+
+		for (int m = 0; m < move_num; m++) {
+			int n = next_idx[m];
+			if (closed[n])
+				continue;
+
+			int next_length = length_from_start[cur_idx] + next_cost[m];
+			if (!search_queue.contains(n)) {
+				int length_to_goal = (engine == Engine::BFS) ? 0 : shortestLength(n / col, n % col, goal);
+				int score = (engine == Engine::GBS) ? length_to_goal : next_length + length_to_goal;
+				length_from_start[n] = next_length;
+				parent[n] = cur_idx;
+				search_queue.push(OpenNode(score, length_to_goal, n));
+			}
+			else if (next_length < length_from_start[n]) {
+				length_from_start[n] = next_length;
+				parent[n] = cur_idx;
+				if (engine != Engine::GBS)
+					search_queue.decreaseKey(n, next_length + search_queue.at(n).length_to_goal);
+			}
+		}
+	}
+
+	// make result road to start point from goal
+	// macro edge -> every cell on the straight line between parent and child
+	if (goal_idx != -1) {
+		res.length = length_from_start[goal_idx] - 1;
+
+		int track_road = goal_idx;
+		while (track_road != start_idx) {
+			int prev = parent[track_road];
+			int prev_row = prev / col;
+			int prev_col = prev % col;
+			int step_row = (track_road / col > prev_row) - (track_road / col < prev_row);
+			int step_col = (track_road % col > prev_col) - (track_road % col < prev_col);
+
+			int r = prev_row;
+			int c = prev_col;
+			while (r * col + c != track_road) {
+				if (r * col + c != start_idx)
+					map[r][c] = Map::ROAD_G;
+
+				r += step_row;
+				c += step_col;
+			}
+
+			track_road = prev;
+		}
+	}
+	// no result
+	else
+		res.length = -1;
+
+	return res;
+}
+
+// greedy decomposition -> grow each rectangle right first, then down
+// rect_id of every ROAD cell, -1 for the other cells
+void decomposeRect(Map **map, int row, int col, vector<Rect> &rect, vector<int> &rect_id) {
+	rect_id.assign(row * col, -1);
+
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			if (map[i][j] != Map::ROAD || rect_id[i * col + j] != -1)
+				continue;
+
+			int col1 = j;
+			while (col1 + 1 < col && map[i][col1 + 1] == Map::ROAD && rect_id[i * col + col1 + 1] == -1)
+				col1++;
+
+			int row1 = i;
+			while (row1 + 1 < row) {
+				bool empty = true;
+				for (int c = j; c <= col1 && empty; c++)
+					empty = (map[row1 + 1][c] == Map::ROAD && rect_id[(row1 + 1) * col + c] == -1);
+
+				if (!empty)
+					break;
+
+				row1++;
+			}
+
+			int id = static_cast<int>(rect.size());
+			rect.emplace_back(i, j, row1, col1);
+			for (int r = i; r <= row1; r++)
+				for (int c = j; c <= col1; c++)
+					rect_id[r * col + c] = id;
+		}
+	}
+}
+
+// find successors of cell in reduced graph, return number of successors
+// 1. neighbour cell outside own rectangle (or any neighbour of start cell)
+// 2. neighbour perimeter cell of own rectangle
+// 3. macro edge -> opposite side of own rectangle on the same row or col
+int findMacroMoves(Map **map, const vector<Rect> &rect, const vector<int> &rect_id, int row, int col,
+		int cur_idx, int *next_idx, int *next_cost) {
+	const int DIR_ROW[4] = {-1, 0, 1, 0};
+	const int DIR_COL[4] = {0, 1, 0, -1};
+
+	int move_num = 0;
+	int cur_row = cur_idx / col;
+	int cur_col = cur_idx % col;
+	int id = rect_id[cur_idx];
+
+	for (int d = 0; d < 4; d++) {
+		int next_row = cur_row + DIR_ROW[d];
+		int next_col = cur_col + DIR_COL[d];
+		if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+			continue;
+
+		Map next_cell = map[next_row][next_col];
+		if (next_cell != Map::ROAD && next_cell != Map::GOAL)
+			continue;
+
+		// interior cell of own rectangle is pruned
+		int n = next_row * col + next_col;
+		if (id != -1 && rect_id[n] == id) {
+			const Rect &r = rect[id];
+			if (next_row != r.row0 && next_row != r.row1 && next_col != r.col0 && next_col != r.col1)
+				continue;
+		}
+
+		next_idx[move_num] = n;
+		next_cost[move_num] = 1;
+		move_num++;
+	}
+
+	if (id == -1)
+		return move_num;
+
+	// macro edges across own rectangle
+	const Rect &r = rect[id];
+	if (r.row1 - r.row0 > 1) {
+		if (cur_row == r.row0) {
+			next_idx[move_num] = r.row1 * col + cur_col;
+			next_cost[move_num++] = r.row1 - r.row0;
+		}
+		if (cur_row == r.row1) {
+			next_idx[move_num] = r.row0 * col + cur_col;
+			next_cost[move_num++] = r.row1 - r.row0;
+		}
+	}
+
+	if (r.col1 - r.col0 > 1) {
+		if (cur_col == r.col0) {
+			next_idx[move_num] = cur_row * col + r.col1;
+			next_cost[move_num++] = r.col1 - r.col0;
+		}
+		if (cur_col == r.col1) {
+			next_idx[move_num] = cur_row * col + r.col0;
+			next_cost[move_num++] = r.col1 - r.col0;
+		}
+	}
+
+	return move_num;
+}
+
+// calc shortest length to several goals
+int shortestLength(int row, int col, vector<Point> &goal) {
+	int length = INT_MAX;
+
+	Point cur_p(row, col);
+	for (uint i = 0; i < goal.size(); i++) {
+		int curLength = DISTANCE(cur_p, goal[i]);
+
+		if (length > curLength)
+			length = curLength;
+	}
+
+	return length;
+}
@@ -0,0 +1,1196 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell index
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+} OpenNode;
+
+// open list -> indexed 4-ary min heap of open nodes
+// pos keeps heap position of every cell (-1 -> not in heap) for decrease-key
+typedef struct OpenHeap {
+	OpenHeap(int);
+	bool empty() const;
+	int size() const;
+	bool contains(int) const;
+	const OpenNode &top() const;
+	const OpenNode &at(int) const;
+	void push(const OpenNode &);
+	void pop();
+	void clear();
+	void decreaseKey(int, int);
+	void siftUp(int);
+	void siftDown(int);
+
+	vector<OpenNode> heap;
+	vector<int> pos;
+} OpenHeap;
+
+// result info -> length, time, road directions from start
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+	string road;
+} Result;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// resident map -> flat cells, start and goals, content and goal set hashes, memory size for the cache limit
+typedef struct CachedMap {
+	size_t bytes() const;
+
+	int row;
+	int col;
+	vector<Map> cell;
+	Point start;
+	vector<Point> goal;
+	uint64_t version;
+	uint64_t goal_hash;
+} CachedMap;
+
+// LRU map cache with memory limit -> maps are shared with running searches
+typedef struct MapCache {
+	MapCache(size_t);
+	shared_ptr<const CachedMap> get(const string &, string &);
+	shared_ptr<const CachedMap> edit(const string &, int, int, Map, uint64_t &, string &);
+	void evict();
+
+	mutex lock;
+	size_t limit;
+	size_t bytes;
+	long long hits;
+	long long misses;
+	long long evictions;
+	list<string> order;
+	unordered_map<string, pair<shared_ptr<const CachedMap>, list<string>::iterator> > entry;
+} MapCache;
+
+// path cache key -> map version, goal set hash, start cell index
+typedef struct PathKey {
+	PathKey(uint64_t, uint64_t, int);
+	bool operator==(const PathKey &) const;
+
+	uint64_t version;
+	uint64_t goal_hash;
+	int cell;
+} PathKey;
+
+typedef struct PathKeyHash {
+	size_t operator()(const PathKey &) const;
+} PathKeyHash;
+
+// cached road -> 2 bits per move (U, R, D, L), 4 moves per byte
+typedef struct CachedPath {
+	size_t bytes() const;
+
+	int length;
+	int time;
+	int moves;
+	int col;
+	vector<uint8_t> road;
+} CachedPath;
+
+// LRU path cache with memory limit
+// cells on every cached road are indexed -> a road through the start answers the query with its rest
+typedef struct PathCache {
+	PathCache(size_t);
+	bool find(const PathKey &, Result &);
+	void insert(const PathKey &, const Result &, int);
+	void invalidate(uint64_t);
+	void erase(const PathKey &);
+
+	mutex lock;
+	size_t limit;
+	size_t bytes;
+	long long hits;
+	long long subpath_hits;
+	long long misses;
+	long long evictions;
+	long long invalidations;
+	list<PathKey> order;
+	unordered_map<PathKey, pair<CachedPath, list<PathKey>::iterator>, PathKeyHash> entry;
+	unordered_map<PathKey, pair<PathKey, int>, PathKeyHash> through;
+} PathCache;
+
+// per-thread search buffers -> reused for every query of the thread
+// stamp marks closed cells of the current search -> no clear between searches
+typedef struct SearchBuffer {
+	SearchBuffer();
+	void reserve(int);
+
+	OpenHeap search_queue;
+	vector<int> length_from_start;
+	vector<int> parent;
+	vector<int> stamp;
+	int search_id;
+} SearchBuffer;
+
+// client connection -> socket and bytes of a request line not received completely yet
+typedef struct Connection {
+	Connection(int);
+
+	int fd;
+	string pending;
+} Connection;
+
+// queue of readable connections of the thread pool
+// a worker answers the requests of one read and gives the connection back to the poll loop,
+// so idle persistent clients do not hold a worker
+// wake_fd -> pipe written on give back, wakes the poll loop to watch the connection again
+typedef struct ConnectionQueue {
+	ConnectionQueue();
+	void push(shared_ptr<Connection>);
+	shared_ptr<Connection> pop();
+	void giveBack(shared_ptr<Connection>);
+	void takeIdle(vector<shared_ptr<Connection> > &);
+
+	mutex lock;
+	condition_variable ready;
+	list<shared_ptr<Connection> > readable;
+	vector<shared_ptr<Connection> > idle;
+	int wake_fd[2];
+} ConnectionQueue;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+// heap size is bounded by cell_num
+OpenHeap::OpenHeap(int cell_num)
+	: pos(cell_num, -1) {}
+
+bool OpenHeap::empty() const {
+	return heap.empty();
+}
+
+int OpenHeap::size() const {
+	return static_cast<int>(heap.size());
+}
+
+bool OpenHeap::contains(int cell) const {
+	return pos[cell] != -1;
+}
+
+const OpenNode &OpenHeap::top() const {
+	return heap[0];
+}
+
+const OpenNode &OpenHeap::at(int cell) const {
+	return heap[pos[cell]];
+}
+
+void OpenHeap::push(const OpenNode &node) {
+	heap.push_back(node);
+	siftUp(size() - 1);
+}
+
+void OpenHeap::pop() {
+	pos[heap[0].cell] = -1;
+
+	OpenNode last = heap.back();
+	heap.pop_back();
+	if (!heap.empty()) {
+		heap[0] = last;
+		siftDown(0);
+	}
+}
+
+// remove remaining nodes -> pos of every cell is -1 again
+void OpenHeap::clear() {
+	for (uint i = 0; i < heap.size(); i++)
+		pos[heap[i].cell] = -1;
+	heap.clear();
+}
+
+// set smaller score of cell in heap
+void OpenHeap::decreaseKey(int cell, int score) {
+	int i = pos[cell];
+	heap[i].score = score;
+	siftUp(i);
+}
+
+void OpenHeap::siftUp(int i) {
+	OpenNode node = heap[i];
+
+	while (i > 0) {
+		int parent = (i - 1) / 4;
+		if (!(heap[parent] > node))
+			break;
+
+		heap[i] = heap[parent];
+		pos[heap[i].cell] = i;
+		i = parent;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+void OpenHeap::siftDown(int i) {
+	OpenNode node = heap[i];
+	int n = size();
+
+	while (true) {
+		int first_child = 4 * i + 1;
+		if (first_child >= n)
+			break;
+
+		// smallest of up to 4 children
+		int best = first_child;
+		int last_child = min(first_child + 4, n);
+		for (int c = first_child + 1; c < last_child; c++)
+			if (heap[best] > heap[c])
+				best = c;
+
+		if (!(node > heap[best]))
+			break;
+
+		heap[i] = heap[best];
+		pos[heap[i].cell] = i;
+		i = best;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+Result::Result()
+	: length(0), time(0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+	road = res.road;
+
+	return *this;
+}
+
+size_t CachedMap::bytes() const {
+	return sizeof(CachedMap) + cell.size() * sizeof(Map) + goal.size() * sizeof(Point);
+}
+
+MapCache::MapCache(size_t limit_)
+	: limit(limit_), bytes(0), hits(0), misses(0), evictions(0) {}
+
+PathKey::PathKey(uint64_t version_, uint64_t goal_hash_, int cell_)
+	: version(version_), goal_hash(goal_hash_), cell(cell_) {}
+
+bool PathKey::operator==(const PathKey &k) const {
+	return (version == k.version && goal_hash == k.goal_hash && cell == k.cell);
+}
+
+size_t PathKeyHash::operator()(const PathKey &k) const {
+	return static_cast<size_t>(k.version ^ (k.goal_hash * 31) ^ (static_cast<uint64_t>(k.cell) * 0x9E3779B97F4A7C15ULL));
+}
+
+// road bytes and one through index entry per road cell
+size_t CachedPath::bytes() const {
+	return sizeof(CachedPath) + sizeof(PathKey) + road.size() + moves * (2 * sizeof(PathKey) + sizeof(int));
+}
+
+PathCache::PathCache(size_t limit_)
+	: limit(limit_), bytes(0), hits(0), subpath_hits(0), misses(0), evictions(0), invalidations(0) {}
+
+SearchBuffer::SearchBuffer()
+	: search_queue(0), search_id(0) {}
+
+// grow buffers for map of cell_num cells
+void SearchBuffer::reserve(int cell_num) {
+	if (static_cast<int>(stamp.size()) >= cell_num)
+		return;
+
+	search_queue.pos.assign(cell_num, -1);
+	length_from_start.assign(cell_num, 0);
+	parent.assign(cell_num, -1);
+	stamp.assign(cell_num, 0);
+}
+
+Connection::Connection(int fd_)
+	: fd(fd_) {}
+
+ConnectionQueue::ConnectionQueue() {
+	wake_fd[0] = -1;
+	wake_fd[1] = -1;
+}
+
+void ConnectionQueue::push(shared_ptr<Connection> connection) {
+	{
+		lock_guard<mutex> guard(lock);
+		readable.push_back(connection);
+	}
+
+	ready.notify_one();
+}
+
+shared_ptr<Connection> ConnectionQueue::pop() {
+	unique_lock<mutex> guard(lock);
+	ready.wait(guard, [this]() { return !readable.empty(); });
+
+	shared_ptr<Connection> connection = readable.front();
+	readable.pop_front();
+
+	return connection;
+}
+
+// connection waits for its next request in the poll loop
+void ConnectionQueue::giveBack(shared_ptr<Connection> connection) {
+	{
+		lock_guard<mutex> guard(lock);
+		idle.push_back(connection);
+	}
+
+	char wake = 0;
+	if (write(wake_fd[1], &wake, 1) < 0)
+		cerr << "poll loop cannot be woken" << endl;
+}
+
+// move given back connections to the poll list
+void ConnectionQueue::takeIdle(vector<shared_ptr<Connection> > &polled) {
+	lock_guard<mutex> guard(lock);
+	polled.insert(polled.end(), idle.begin(), idle.end());
+	idle.clear();
+}
+
+bool loadMap(const string &, CachedMap &, string &);
+uint64_t cellHash(uint64_t);
+Result calc(const CachedMap &, Point &, SearchBuffer &);
+string handleRequest(const string &, MapCache &, PathCache &, SearchBuffer &);
+bool parseIndex(const string &, int, int &);
+bool serveConnection(Connection &, MapCache &, PathCache &, SearchBuffer &);
+int runServer(const string &, int, size_t, size_t);
+int runClient(const string &, const string &, int);
+int shortestLength(int, int, const vector<Point> &);
+
+// usage:
+//   ./SRV serve [socket] [threads] [cache_mb] [path_cache_mb]
+//                                             -> solver daemon on unix socket (solver.sock, 4 threads, 256 MB, 64 MB)
+//   ./SRV client <socket> "<request>" [repeat] -> send request, print response and mean latency
+// request / response -> one line each
+//   SOLVE <map file> [row col]    -> OK <length> <time> <road> | OK -1 <time> (no result) | ERR <message>
+//                                    road is U/R/D/L moves from start, start is the 3 cell unless row col is given
+//                                    time is 0 when the road comes from the path cache
+//   EDIT <map file> <row> <col> <1|2>
+//                                 -> OK version=<hash> | ERR <message>
+//                                    set WALL or ROAD on resident map, cached roads of old version are dropped
+//                                    edit lives until the map is evicted and loaded from file again
+//   STAT                          -> OK maps=<n> bytes=<n> hits=<n> misses=<n> evictions=<n> paths=<n> path_bytes=<n>
+//                                    path_hits=<n> subpath_hits=<n> path_misses=<n> path_evictions=<n> invalidations=<n>
+int main (int argc, char *argv[]) {
+	if (argc > 1 && strcmp(argv[1], "serve") == 0) {
+		string socket_path = (argc > 2) ? argv[2] : "solver.sock";
+		int thread_num = (argc > 3) ? atoi(argv[3]) : 4;
+		long cache_mb = (argc > 4) ? atol(argv[4]) : 256;
+		long path_cache_mb = (argc > 5) ? atol(argv[5]) : 64;
+		if (thread_num <= 0 || cache_mb <= 0 || path_cache_mb <= 0) {
+			cerr << "threads or cache value error" << endl;
+			return -1;
+		}
+
+		return runServer(socket_path, thread_num, static_cast<size_t>(cache_mb) << 20, static_cast<size_t>(path_cache_mb) << 20);
+	}
+
+	if (argc > 3 && strcmp(argv[1], "client") == 0) {
+		int repeat = (argc > 4) ? atoi(argv[4]) : 1;
+		if (repeat <= 0) {
+			cerr << "repeat value error" << endl;
+			return -1;
+		}
+
+		return runClient(argv[2], argv[3], repeat);
+	}
+
+	cerr << "usage: serve [socket] [threads] [cache_mb] [path_cache_mb] | client <socket> <request> [repeat]" << endl;
+
+	return -1;
+}
+
+// read map file with the same rules as input.txt
+bool loadMap(const string &filename, CachedMap &map, string &error) {
+	ifstream input_f(filename);
+	if (!input_f.is_open()) {
+		error = "input file is not exist";
+		return false;
+	}
+
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		error = "row or col value error";
+		return false;
+	}
+
+	map.row = row;
+	map.col = col;
+	map.cell.resize(row * col);
+
+	int map_1cell_data = 0;
+	for (int i = 0; i < row * col; i++) {
+		if (!(input_f >> map_1cell_data)) {
+			error = "input file do not have sufficient map data";
+			return false;
+		}
+
+		switch (map_1cell_data) {
+			case 1:
+				map.cell[i] = Map::WALL;
+				break;
+
+			case 2:
+				map.cell[i] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map.cell[i] = Map::START;
+				if (map.start.row != -1) {
+					error = "start point is duplicated";
+					return false;
+				}
+
+				map.start = Point(i / col, i % col);
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map.cell[i] = Map::GOAL;
+				map.goal.emplace_back(i / col, i % col);
+				break;
+
+			default:
+				error = "input file have unknown map data";
+				return false;
+		}
+	}
+
+	if (map.goal.size() == 0) {
+		error = "input file start or goal data error";
+		return false;
+	}
+
+	// version -> xor of every cell hash, an edit updates it with two xors
+	map.version = cellHash((static_cast<uint64_t>(row) << 32) | static_cast<uint64_t>(col));
+	for (int i = 0; i < row * col; i++)
+		map.version ^= cellHash((static_cast<uint64_t>(i) << 3) | static_cast<uint64_t>(map.cell[i]));
+
+	map.goal_hash = 0;
+	for (uint i = 0; i < map.goal.size(); i++)
+		map.goal_hash ^= cellHash((1ULL << 62) | static_cast<uint64_t>(map.goal[i].row * col + map.goal[i].col));
+
+	return true;
+}
+
+// mix 64-bit value (splitmix64 finalizer)
+uint64_t cellHash(uint64_t k) {
+	k += 0x9E3779B97F4A7C15ULL;
+	k = (k ^ (k >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	k = (k ^ (k >> 27)) * 0x94D049BB133111EBULL;
+
+	return k ^ (k >> 31);
+}
+
+// find map in cache or load it, evict least recently used maps over the memory limit
+shared_ptr<const CachedMap> MapCache::get(const string &filename, string &error) {
+	{
+		lock_guard<mutex> guard(lock);
+
+		auto it = entry.find(filename);
+		if (it != entry.end()) {
+			hits++;
+			order.splice(order.begin(), order, it->second.second);
+			return it->second.first;
+		}
+
+		misses++;
+	}
+
+	// load without lock -> other queries keep running
+	shared_ptr<CachedMap> map = make_shared<CachedMap>();
+	if (!loadMap(filename, *map, error))
+		return shared_ptr<const CachedMap>();
+
+	lock_guard<mutex> guard(lock);
+
+	// another thread loaded the same map meanwhile
+	auto it = entry.find(filename);
+	if (it != entry.end())
+		return it->second.first;
+
+	order.push_front(filename);
+	entry[filename] = make_pair(shared_ptr<const CachedMap>(map), order.begin());
+	bytes += map->bytes();
+	evict();
+
+	return map;
+}
+
+// copy resident map with one WALL / ROAD cell changed and replace it in the cache
+// running searches keep the old map, old_version -> version before the edit
+shared_ptr<const CachedMap> MapCache::edit(const string &filename, int row, int col, Map value, uint64_t &old_version, string &error) {
+	shared_ptr<const CachedMap> map = get(filename, error);
+	if (!map)
+		return map;
+
+	lock_guard<mutex> guard(lock);
+
+	// another edit may have replaced the map meanwhile
+	auto it = entry.find(filename);
+	if (it != entry.end())
+		map = it->second.first;
+
+	if (row < 0 || row >= map->row || col < 0 || col >= map->col) {
+		error = "edit point error";
+		return shared_ptr<const CachedMap>();
+	}
+
+	int cell = row * map->col + col;
+	Map old_value = map->cell[cell];
+	if (old_value != Map::WALL && old_value != Map::ROAD) {
+		error = "start or goal cannot be edited";
+		return shared_ptr<const CachedMap>();
+	}
+
+	shared_ptr<CachedMap> edited = make_shared<CachedMap>(*map);
+	edited->cell[cell] = value;
+	edited->version ^= cellHash((static_cast<uint64_t>(cell) << 3) | static_cast<uint64_t>(old_value));
+	edited->version ^= cellHash((static_cast<uint64_t>(cell) << 3) | static_cast<uint64_t>(value));
+	old_version = map->version;
+
+	// map was evicted meanwhile -> resident again
+	if (it == entry.end()) {
+		order.push_front(filename);
+		entry[filename] = make_pair(shared_ptr<const CachedMap>(edited), order.begin());
+		bytes += edited->bytes();
+		evict();
+	}
+	else
+		it->second.first = edited;
+
+	return edited;
+}
+
+// evict least recently used maps over the memory limit, lock is held by the caller
+// newest map always stays even if it is bigger than the limit
+void MapCache::evict() {
+	while (bytes > limit && order.size() > 1) {
+		auto victim = entry.find(order.back());
+		bytes -= victim->second.first->bytes();
+		entry.erase(victim);
+		order.pop_back();
+		evictions++;
+	}
+}
+
+// find road of key, or the rest of a cached road through the start cell
+// time of a cached road is 0 -> no search
+bool PathCache::find(const PathKey &key, Result &res) {
+	const char DIR_NAME[4] = {'U', 'R', 'D', 'L'};
+	lock_guard<mutex> guard(lock);
+
+	const CachedPath *path = NULL;
+	int offset = 0;
+
+	auto it = entry.find(key);
+	if (it != entry.end()) {
+		hits++;
+		order.splice(order.begin(), order, it->second.second);
+		path = &it->second.first;
+	}
+	else {
+		auto through_it = through.find(key);
+		if (through_it == through.end()) {
+			misses++;
+			return false;
+		}
+
+		auto owner = entry.find(through_it->second.first);
+		subpath_hits++;
+		order.splice(order.begin(), order, owner->second.second);
+		path = &owner->second.first;
+		offset = through_it->second.second;
+	}
+
+	res.time = 0;
+	res.length = (path->length == -1) ? -1 : path->moves - offset - 1;
+	res.road.clear();
+	for (int m = offset; m < path->moves; m++)
+		res.road.push_back(DIR_NAME[(path->road[m / 4] >> ((m % 4) * 2)) & 3]);
+
+	return true;
+}
+
+// keep road of key, evict least recently used roads over the memory limit
+void PathCache::insert(const PathKey &key, const Result &res, int col) {
+	lock_guard<mutex> guard(lock);
+	if (entry.find(key) != entry.end())
+		return;
+
+	CachedPath path;
+	path.length = res.length;
+	path.time = res.time;
+	path.moves = static_cast<int>(res.road.size());
+	path.col = col;
+	path.road.assign((path.moves + 3) / 4, 0);
+
+	// index every cell between start and goal -> move offset from start
+	int cell = key.cell;
+	for (int m = 0; m < path.moves; m++) {
+		int d = 0;
+		switch (res.road[m]) {
+			case 'U':
+				d = 0;
+				cell -= col;
+				break;
+
+			case 'R':
+				d = 1;
+				cell += 1;
+				break;
+
+			case 'D':
+				d = 2;
+				cell += col;
+				break;
+
+			default:
+				d = 3;
+				cell -= 1;
+				break;
+		}
+
+		path.road[m / 4] |= static_cast<uint8_t>(d << ((m % 4) * 2));
+		if (m + 1 < path.moves)
+			through.emplace(PathKey(key.version, key.goal_hash, cell), make_pair(key, m + 1));
+	}
+
+	order.push_front(key);
+	bytes += path.bytes();
+	entry.emplace(key, make_pair(path, order.begin()));
+
+	// newest road always stays even if it is bigger than the limit
+	while (bytes > limit && order.size() > 1) {
+		erase(order.back());
+		evictions++;
+	}
+}
+
+// drop every road of old map version
+void PathCache::invalidate(uint64_t version) {
+	lock_guard<mutex> guard(lock);
+
+	for (auto it = order.begin(); it != order.end();) {
+		PathKey key = *it;
+		++it;
+
+		if (key.version == version) {
+			erase(key);
+			invalidations++;
+		}
+	}
+}
+
+// remove road and its through index entries, lock must be held
+void PathCache::erase(const PathKey &key) {
+	const int DIR_ROW[4] = {-1, 0, 1, 0};
+	const int DIR_COL[4] = {0, 1, 0, -1};
+
+	auto it = entry.find(key);
+	const CachedPath &path = it->second.first;
+
+	int cell = key.cell;
+	for (int m = 0; m + 1 < path.moves; m++) {
+		int d = (path.road[m / 4] >> ((m % 4) * 2)) & 3;
+		cell += DIR_ROW[d] * path.col + DIR_COL[d];
+
+		auto through_it = through.find(PathKey(key.version, key.goal_hash, cell));
+		if (through_it != through.end() && through_it->second.first == key)
+			through.erase(through_it);
+	}
+
+	bytes -= path.bytes();
+	order.erase(it->second.second);
+	entry.erase(it);
+}
+
+// calc result road using A* search algorithm with the thread's search buffer
+Result calc(const CachedMap &map, Point &start, SearchBuffer &buffer) {
+	Result res;
+	int row = map.row;
+	int col = map.col;
+
+	buffer.reserve(row * col);
+	if (buffer.search_id == INT_MAX) {
+		fill(buffer.stamp.begin(), buffer.stamp.end(), 0);
+		buffer.search_id = 0;
+	}
+	buffer.search_id++;
+
+	OpenHeap &search_queue = buffer.search_queue;
+	vector<int> &length_from_start = buffer.length_from_start;
+	vector<int> &parent = buffer.parent;
+	vector<int> &stamp = buffer.stamp;
+
+	// cell index offset of UP, RIGHT, DOWN, LEFT
+	const char DIR_NAME[4] = {'U', 'R', 'D', 'L'};
+	int dir_offset[4] = {-col, 1, col, -1};
+
+	int start_idx = start.row * col + start.col;
+	length_from_start[start_idx] = 0;
+	parent[start_idx] = start_idx;
+	search_queue.push(OpenNode(0, 0, start_idx));
+	int goal_idx = -1;
+
+	// search continuously until finding result
+	// search_queue is empty when there is no result
+	while (!search_queue.empty()) {
+		int cur_idx = search_queue.top().cell;
+		search_queue.pop();
+
+		res.time++;
+
+		// check if goal node
+		if (map.cell[cur_idx] == Map::GOAL) {
+			goal_idx = cur_idx;
+			break;
+		}
+
+		// closed set -> length from start of expanded cell is final
+		stamp[cur_idx] = buffer.search_id;
+
+		int cur_row = cur_idx / col;
+		int cur_col = cur_idx % col;
+		int next_length = length_from_start[cur_idx] + 1;
+
+		for (int d = 0; d < 4; d++) {
+			if ((d == 0 && cur_row == 0) || (d == 1 && cur_col == col - 1) ||
+					(d == 2 && cur_row == row - 1) || (d == 3 && cur_col == 0))
+				continue;
+
+			int next_idx = cur_idx + dir_offset[d];
+			if ((map.cell[next_idx] != Map::ROAD && map.cell[next_idx] != Map::GOAL) || stamp[next_idx] == buffer.search_id)
+				continue;
+
+			if (!search_queue.contains(next_idx)) {
+				int length_to_goal = shortestLength(next_idx / col, next_idx % col, map.goal);
+				length_from_start[next_idx] = next_length;
+				parent[next_idx] = cur_idx;
+				search_queue.push(OpenNode(next_length + length_to_goal, length_to_goal, next_idx));
+			}
+			else if (next_length < length_from_start[next_idx]) {
+				length_from_start[next_idx] = next_length;
+				parent[next_idx] = cur_idx;
+				search_queue.decreaseKey(next_idx, next_length + search_queue.at(next_idx).length_to_goal);
+			}
+		}
+	}
+
+	search_queue.clear();
+
+	// make result road to start point from goal
+	if (goal_idx != -1) {
+		res.length = length_from_start[goal_idx] - 1;
+
+		int track_road = goal_idx;
+		while (track_road != start_idx) {
+			int prev = parent[track_road];
+			for (int d = 0; d < 4; d++)
+				if (prev + dir_offset[d] == track_road)
+					res.road.push_back(DIR_NAME[d]);
+
+			track_road = prev;
+		}
+
+		reverse(res.road.begin(), res.road.end());
+	}
+	// no result
+	else
+		res.length = -1;
+
+	return res;
+}
+
+// one request line -> one response line
+string handleRequest(const string &request, MapCache &cache, PathCache &path_cache, SearchBuffer &buffer) {
+	stringstream ss(request);
+	string command;
+	ss >> command;
+
+	if (command == "SOLVE") {
+		string filename;
+		if (!(ss >> filename))
+			return "ERR map file is missing";
+
+		string error;
+		shared_ptr<const CachedMap> map = cache.get(filename, error);
+		if (!map)
+			return "ERR " + error;
+
+		// start point tokens must be exactly two integers in the map
+		Point start = map->start;
+		string row_token;
+		string col_token;
+		string extra_token;
+		if (ss >> row_token) {
+			if (!(ss >> col_token) || (ss >> extra_token) ||
+					!parseIndex(row_token, map->row, start.row) || !parseIndex(col_token, map->col, start.col))
+				return "ERR start point error";
+		}
+
+		if (start.row < 0 || start.row >= map->row || start.col < 0 || start.col >= map->col ||
+				map->cell[start.row * map->col + start.col] == Map::WALL ||
+				map->cell[start.row * map->col + start.col] == Map::GOAL)
+			return "ERR start point error";
+
+		// cached road of the same map version and goal set
+		Result res;
+		PathKey key(map->version, map->goal_hash, start.row * map->col + start.col);
+		if (!path_cache.find(key, res)) {
+			res = calc(*map, start, buffer);
+			path_cache.insert(key, res, map->col);
+		}
+
+		stringstream response;
+		response << "OK " << res.length << " " << res.time;
+		if (res.length != -1)
+			response << " " << res.road;
+
+		return response.str();
+	}
+
+	if (command == "EDIT") {
+		// edit tokens must be exactly row, col and 1 or 2, row and col are checked against the map by edit
+		string filename;
+		string row_token;
+		string col_token;
+		string value_token;
+		string extra_token;
+		int row = 0;
+		int col = 0;
+		int value = 0;
+		if (!(ss >> filename >> row_token >> col_token >> value_token) || (ss >> extra_token) ||
+				!parseIndex(row_token, INT_MAX, row) || !parseIndex(col_token, INT_MAX, col) ||
+				!parseIndex(value_token, 3, value) || (value != 1 && value != 2))
+			return "ERR edit request error";
+
+		string error;
+		uint64_t old_version = 0;
+		shared_ptr<const CachedMap> map = cache.edit(filename, row, col, static_cast<Map>(value), old_version, error);
+		if (!map)
+			return "ERR " + error;
+
+		if (map->version != old_version)
+			path_cache.invalidate(old_version);
+
+		stringstream response;
+		response << "OK version=" << hex << map->version;
+
+		return response.str();
+	}
+
+	if (command == "STAT") {
+		stringstream response;
+		{
+			lock_guard<mutex> guard(cache.lock);
+			response << "OK maps=" << cache.entry.size() << " bytes=" << cache.bytes << " hits=" << cache.hits
+				<< " misses=" << cache.misses << " evictions=" << cache.evictions;
+		}
+		{
+			lock_guard<mutex> guard(path_cache.lock);
+			response << " paths=" << path_cache.entry.size() << " path_bytes=" << path_cache.bytes
+				<< " path_hits=" << path_cache.hits << " subpath_hits=" << path_cache.subpath_hits
+				<< " path_misses=" << path_cache.misses << " path_evictions=" << path_cache.evictions
+				<< " invalidations=" << path_cache.invalidations;
+		}
+
+		return response.str();
+	}
+
+	return "ERR unknown request";
+}
+
+// parse decimal index in [0, limit), false for any other token
+bool parseIndex(const string &token, int limit, int &index) {
+	char *end = NULL;
+	errno = 0;
+	long value = strtol(token.c_str(), &end, 10);
+	if (errno != 0 || end == token.c_str() || *end != '\0' || value < 0 || value >= limit)
+		return false;
+
+	index = static_cast<int>(value);
+
+	return true;
+}
+
+// read once from a readable connection and answer every complete request line
+// false when the client closed the connection
+bool serveConnection(Connection &connection, MapCache &cache, PathCache &path_cache, SearchBuffer &buffer) {
+	char data[4096];
+
+	ssize_t n = read(connection.fd, data, sizeof(data));
+	if (n <= 0)
+		return false;
+
+	connection.pending.append(data, n);
+
+	size_t line_end;
+	while ((line_end = connection.pending.find('\n')) != string::npos) {
+		string response = handleRequest(connection.pending.substr(0, line_end), cache, path_cache, buffer) + "\n";
+		connection.pending.erase(0, line_end + 1);
+
+		size_t sent = 0;
+		while (sent < response.size()) {
+			ssize_t m = write(connection.fd, response.data() + sent, response.size() - sent);
+			if (m <= 0)
+				return false;
+
+			sent += m;
+		}
+	}
+
+	return true;
+}
+
+// accept connections and poll idle ones, hand readable connections to the thread pool
+int runServer(const string &socket_path, int thread_num, size_t cache_limit, size_t path_cache_limit) {
+	signal(SIGPIPE, SIG_IGN);
+
+	int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (server_fd < 0) {
+		cerr << "socket cannot be created" << endl;
+		return -1;
+	}
+
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (socket_path.size() >= sizeof(addr.sun_path)) {
+		cerr << "socket path is too long" << endl;
+		close(server_fd);
+		return -1;
+	}
+	strcpy(addr.sun_path, socket_path.c_str());
+
+	unlink(socket_path.c_str());
+	if (bind(server_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 || listen(server_fd, 64) < 0) {
+		cerr << "socket cannot be bound" << endl;
+		close(server_fd);
+		return -1;
+	}
+
+	MapCache cache(cache_limit);
+	PathCache path_cache(path_cache_limit);
+	ConnectionQueue connection;
+	vector<thread> workers;
+
+	if (pipe(connection.wake_fd) < 0) {
+		cerr << "wake pipe cannot be created" << endl;
+		close(server_fd);
+		return -1;
+	}
+
+	for (int t = 0; t < thread_num; t++) {
+		workers.emplace_back([&]() {
+			SearchBuffer buffer;
+
+			while (true) {
+				shared_ptr<Connection> client = connection.pop();
+				if (serveConnection(*client, cache, path_cache, buffer))
+					connection.giveBack(client);
+				else
+					close(client->fd);
+			}
+		});
+	}
+
+	// poll list -> server socket, wake pipe, then connections waiting for a request
+	vector<shared_ptr<Connection> > polled;
+	vector<struct pollfd> poll_fd;
+
+	while (true) {
+		poll_fd.resize(2 + polled.size());
+		poll_fd[0].fd = server_fd;
+		poll_fd[1].fd = connection.wake_fd[0];
+		for (uint i = 0; i < polled.size(); i++)
+			poll_fd[2 + i].fd = polled[i]->fd;
+		for (uint i = 0; i < poll_fd.size(); i++) {
+			poll_fd[i].events = POLLIN;
+			poll_fd[i].revents = 0;
+		}
+
+		if (poll(poll_fd.data(), poll_fd.size(), -1) < 0)
+			continue;
+
+		// readable or closed connections go to the thread pool
+		uint kept = 0;
+		for (uint i = 0; i < polled.size(); i++) {
+			if (poll_fd[2 + i].revents != 0)
+				connection.push(polled[i]);
+			else
+				polled[kept++] = polled[i];
+		}
+		polled.resize(kept);
+
+		if (poll_fd[1].revents != 0) {
+			char wake[64];
+			if (read(connection.wake_fd[0], wake, sizeof(wake)) > 0)
+				connection.takeIdle(polled);
+		}
+
+		if (poll_fd[0].revents != 0) {
+			int client_fd = accept(server_fd, NULL, NULL);
+			if (client_fd >= 0)
+				polled.push_back(make_shared<Connection>(client_fd));
+		}
+	}
+
+	return 0;
+}
+
+// send request repeat times on one connection, print last response and mean latency
+int runClient(const string &socket_path, const string &request, int repeat) {
+	int client_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+	if (client_fd < 0 || connect(client_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+		cerr << "server is not running" << endl;
+		return -1;
+	}
+
+	string line = request + "\n";
+	string response;
+	char data[4096];
+
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+
+	for (int i = 0; i < repeat; i++) {
+		if (write(client_fd, line.data(), line.size()) != static_cast<ssize_t>(line.size())) {
+			cerr << "request cannot be sent" << endl;
+			close(client_fd);
+			return -1;
+		}
+
+		response.clear();
+		while (response.empty() || response.back() != '\n') {
+			ssize_t n = read(client_fd, data, sizeof(data));
+			if (n <= 0) {
+				cerr << "server closed connection" << endl;
+				close(client_fd);
+				return -1;
+			}
+
+			response.append(data, n);
+		}
+	}
+
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	close(client_fd);
+
+	cout << response;
+	cout << "latency_us=" << chrono::duration<double, micro>(end - begin).count() / repeat << endl;
+
+	return 0;
+}
+
+// calc shortest length to several goals
+int shortestLength(int row, int col, const vector<Point> &goal) {
+	int length = INT_MAX;
+
+	Point cur_p(row, col);
+	for (uint i = 0; i < goal.size(); i++) {
+		int curLength = DISTANCE(cur_p, goal[i]);
+
+		if (length > curLength)
+			length = curLength;
+	}
+
+	return length;
+}
@@ -0,0 +1,649 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, layout cell index, row-major point index
+// ties are broken by row-major point index -> every layout expands cells in the same order
+typedef struct OpenNode {
+	OpenNode(int, int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+	int point;
+} OpenNode;
+
+// open list -> indexed 4-ary min heap of open nodes
+// pos keeps heap position of every cell (-1 -> not in heap) for decrease-key
+typedef struct OpenHeap {
+	OpenHeap(int);
+	bool empty() const;
+	int size() const;
+	bool contains(int) const;
+	const OpenNode &top() const;
+	const OpenNode &at(int) const;
+	void push(const OpenNode &);
+	void pop();
+	void decreaseKey(int, int);
+	void siftUp(int);
+	void siftDown(int);
+
+	vector<OpenNode> heap;
+	vector<int> pos;
+} OpenHeap;
+
+// result info -> length, time, search time
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+	double search_ms;
+} Result;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// cell state bit flag in layout order
+// PASSABLE -> ROAD or GOAL, CLOSED -> expanded
+typedef enum CellState {
+	PASSABLE = 0x01,
+	GOAL_CELL = 0x02,
+	CLOSED = 0x04
+} CellState;
+
+// grid layout -> memory index of (row, col)
+// row-major layout, index = row * col + col
+typedef struct RowMajorLayout {
+	RowMajorLayout(int, int);
+	int index(int, int) const;
+	int size() const;
+
+	int row;
+	int col;
+} RowMajorLayout;
+
+// separable layout -> index = row_part[row] + col_part[col], both parts precomputed
+typedef struct TableLayout {
+	int index(int, int) const;
+	int size() const;
+
+	vector<int> row_part;
+	vector<int> col_part;
+	int cell_num;
+} TableLayout;
+
+// square tile layout -> TILE x TILE cells are stored together, tiles in row-major order
+template <int TILE>
+struct TiledLayout : public TableLayout {
+	TiledLayout(int, int);
+};
+
+// Z-order (Morton) layout inside 64 x 64 blocks, blocks in row-major order
+typedef struct MortonLayout : public TableLayout {
+	MortonLayout(int, int);
+} MortonLayout;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_, int point_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_), point(point_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return point > n.point;
+}
+
+// heap size is bounded by cell_num
+OpenHeap::OpenHeap(int cell_num)
+	: pos(cell_num, -1) {}
+
+bool OpenHeap::empty() const {
+	return heap.empty();
+}
+
+int OpenHeap::size() const {
+	return static_cast<int>(heap.size());
+}
+
+bool OpenHeap::contains(int cell) const {
+	return pos[cell] != -1;
+}
+
+const OpenNode &OpenHeap::top() const {
+	return heap[0];
+}
+
+const OpenNode &OpenHeap::at(int cell) const {
+	return heap[pos[cell]];
+}
+
+void OpenHeap::push(const OpenNode &node) {
+	heap.push_back(node);
+	siftUp(size() - 1);
+}
+
+void OpenHeap::pop() {
+	pos[heap[0].cell] = -1;
+
+	OpenNode last = heap.back();
+	heap.pop_back();
+	if (!heap.empty()) {
+		heap[0] = last;
+		siftDown(0);
+	}
+}
+
+// set smaller score of cell in heap
+void OpenHeap::decreaseKey(int cell, int score) {
+	int i = pos[cell];
+	heap[i].score = score;
+	siftUp(i);
+}
+
+void OpenHeap::siftUp(int i) {
+	OpenNode node = heap[i];
+
+	while (i > 0) {
+		int parent = (i - 1) / 4;
+		if (!(heap[parent] > node))
+			break;
+
+		heap[i] = heap[parent];
+		pos[heap[i].cell] = i;
+		i = parent;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+void OpenHeap::siftDown(int i) {
+	OpenNode node = heap[i];
+	int n = size();
+
+	while (true) {
+		int first_child = 4 * i + 1;
+		if (first_child >= n)
+			break;
+
+		// smallest of up to 4 children
+		int best = first_child;
+		int last_child = min(first_child + 4, n);
+		for (int c = first_child + 1; c < last_child; c++)
+			if (heap[best] > heap[c])
+				best = c;
+
+		if (!(node > heap[best]))
+			break;
+
+		heap[i] = heap[best];
+		pos[heap[i].cell] = i;
+		i = best;
+	}
+
+	heap[i] = node;
+	pos[node.cell] = i;
+}
+
+Result::Result()
+	: length(0), time(0), search_ms(0.0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_), search_ms(0.0) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+	search_ms = res.search_ms;
+
+	return *this;
+}
+
+RowMajorLayout::RowMajorLayout(int row_, int col_)
+	: row(row_), col(col_) {}
+
+int RowMajorLayout::index(int r, int c) const {
+	return r * col + c;
+}
+
+int RowMajorLayout::size() const {
+	return row * col;
+}
+
+int TableLayout::index(int r, int c) const {
+	return row_part[r] + col_part[c];
+}
+
+int TableLayout::size() const {
+	return cell_num;
+}
+
+// row and col are padded to multiple of TILE, padding cells stay WALL
+template <int TILE>
+TiledLayout<TILE>::TiledLayout(int row, int col) {
+	int tile_row = (row + TILE - 1) / TILE;
+	int tile_col = (col + TILE - 1) / TILE;
+	cell_num = tile_row * tile_col * TILE * TILE;
+
+	row_part.resize(row);
+	for (int r = 0; r < row; r++)
+		row_part[r] = (r / TILE) * tile_col * TILE * TILE + (r % TILE) * TILE;
+
+	col_part.resize(col);
+	for (int c = 0; c < col; c++)
+		col_part[c] = (c / TILE) * TILE * TILE + (c % TILE);
+}
+
+// spread low 6 bits of value to even bits -> row bits on even, col bits on odd positions
+static int spreadBits(int value) {
+	int result = 0;
+	for (int b = 0; b < 6; b++)
+		result |= ((value >> b) & 1) << (2 * b);
+
+	return result;
+}
+
+MortonLayout::MortonLayout(int row, int col) {
+	const int BLOCK = 64;
+	int block_row = (row + BLOCK - 1) / BLOCK;
+	int block_col = (col + BLOCK - 1) / BLOCK;
+	cell_num = block_row * block_col * BLOCK * BLOCK;
+
+	row_part.resize(row);
+	for (int r = 0; r < row; r++)
+		row_part[r] = (r / BLOCK) * block_col * BLOCK * BLOCK + spreadBits(r % BLOCK);
+
+	col_part.resize(col);
+	for (int c = 0; c < col; c++)
+		col_part[c] = (c / BLOCK) * BLOCK * BLOCK + (spreadBits(c % BLOCK) << 1);
+}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+// move direction table -> UP, RIGHT, DOWN, LEFT
+const int DIR_ROW[4] = {-1, 0, 1, 0};
+const int DIR_COL[4] = {0, 1, 0, -1};
+
+const char *LAYOUT_NAME[] = {"row", "tile8", "tile16", "morton"};
+
+template <typename Layout>
+Result calc(Map **, int, int, Point &, vector<Point> &, const Layout &, vector<int> &);
+Result calcLayout(int, Map **, int, int, Point &, vector<Point> &, vector<int> &);
+int shortestLength(int, int, vector<Point> &);
+
+// usage:
+//   ./TLS [row|tile8|tile16|morton] -> search with the given grid layout (row by default)
+//   ./TLS compare [trials]          -> search with every layout, report median search time of each
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// layout option
+	int layout_i = 0;
+	int trials = 0;
+	if (argc > 1 && strcmp(argv[1], "compare") == 0) {
+		trials = (argc > 2) ? atoi(argv[2]) : 5;
+		if (trials <= 0) {
+			cerr << "trials value error" << endl;
+			return -1;
+		}
+	}
+	else if (argc > 1) {
+		while (layout_i < 4 && strcmp(LAYOUT_NAME[layout_i], argv[1]) != 0)
+			layout_i++;
+		if (layout_i == 4) {
+			cerr << "unknown layout " << argv[1] << endl;
+			return -1;
+		}
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	Point start;
+	vector<Point> goal;
+	Result result;
+	vector<int> road;
+	vector<double> layout_ms;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point must exist only one
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				if (start.row != -1 || start.col != -1) {
+					cerr << "start point is duplicated" << endl;
+					goto RELEASE_DATA;
+				}
+
+				start.row = row_i;
+				start.col = col_j;
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num == 1
+	// goal num >= 1
+	if (start.row == -1 || start.col == -1 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// calc best result
+	if (trials == 0)
+		result = calcLayout(layout_i, map_info, row, col, start, goal, road);
+	// compare every layout -> median search time of trials
+	else {
+		for (int l = 0; l < 4; l++) {
+			vector<double> ms;
+			for (int t = 0; t < trials; t++) {
+				road.clear();
+				result = calcLayout(l, map_info, row, col, start, goal, road);
+				ms.push_back(result.search_ms);
+			}
+
+			sort(ms.begin(), ms.end());
+			layout_ms.push_back(ms[ms.size() / 2]);
+		}
+	}
+
+	// set Map::ROAD_G
+	for (uint i = 0; i < road.size(); i++)
+		map_info[road[i] / col][road[i] % col] = Map::ROAD_G;
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// best result
+	if (result.length != -1) {
+		output_f << "length=" << result.length << endl;
+		output_f << "time=" << result.time << endl;
+	}
+	// no result
+	else {
+		output_f << "time=" << result.time << endl;
+		output_f << "no result" << endl;
+	}
+
+	// layout comparison block
+	for (uint l = 0; l < layout_ms.size(); l++)
+		output_f << "layout=" << LAYOUT_NAME[l] << " search_ms=" << layout_ms[l] << endl;
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// calc result road with the layout of index layout_i
+Result calcLayout(int layout_i, Map **map, int row, int col, Point &start, vector<Point> &goal, vector<int> &road) {
+	switch (layout_i) {
+		case 1:
+			return calc(map, row, col, start, goal, TiledLayout<8>(row, col), road);
+
+		case 2:
+			return calc(map, row, col, start, goal, TiledLayout<16>(row, col), road);
+
+		case 3:
+			return calc(map, row, col, start, goal, MortonLayout(row, col), road);
+
+		default:
+			return calc(map, row, col, start, goal, RowMajorLayout(row, col), road);
+	}
+}
+
+// calc result road using A* search algorithm over grid stored in Layout order
+// road gets row-major index of every cell between start and goal
+template <typename Layout>
+Result calc(Map **map, int row, int col, Point &start, vector<Point> &goal, const Layout &layout, vector<int> &road) {
+	Result res;
+	int cell_num = layout.size();
+
+	// cell state, length from start and parent direction in layout order
+	// padding cells of layout are not PASSABLE
+	vector<uint8_t> cell_state(cell_num, 0);
+	vector<int> length_from_start(cell_num, 0);
+	vector<uint8_t> parent_dir(cell_num, 0);
+
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			if (map[i][j] == Map::ROAD)
+				cell_state[layout.index(i, j)] = PASSABLE;
+			else if (map[i][j] == Map::GOAL)
+				cell_state[layout.index(i, j)] = PASSABLE | GOAL_CELL;
+		}
+	}
+
+	OpenHeap search_queue(cell_num);
+	int start_idx = layout.index(start.row, start.col);
+	search_queue.push(OpenNode(0, 0, start_idx, start.row * col + start.col));
+	int goal_idx = -1;
+	Point goal_p;
+
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+
+	// search continuously until finding result
+	// search_queue is empty when there is no result
+	while (!search_queue.empty()) {
+		int cur_idx = search_queue.top().cell;
+		Point cur_p(search_queue.top().point / col, search_queue.top().point % col);
+		search_queue.pop();
+
+		res.time++;
+
+		// check if goal node
+		if (cell_state[cur_idx] & GOAL_CELL) {
+			goal_idx = cur_idx;
+			goal_p = cur_p;
+			break;
+		}
+
+		// closed set -> length from start of expanded cell is final
+		cell_state[cur_idx] |= CLOSED;
+		int next_length = length_from_start[cur_idx] + 1;
+
+		for (int d = 0; d < 4; d++) {
+			int next_row = cur_p.row + DIR_ROW[d];
+			int next_col = cur_p.col + DIR_COL[d];
+			if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+				continue;
+
+			int next_idx = layout.index(next_row, next_col);
+			if ((cell_state[next_idx] & (PASSABLE | CLOSED)) != PASSABLE)
+				continue;
+
+			if (!search_queue.contains(next_idx)) {
+				int length_to_goal = shortestLength(next_row, next_col, goal);
+				length_from_start[next_idx] = next_length;
+				parent_dir[next_idx] = static_cast<uint8_t>(d);
+				search_queue.push(OpenNode(next_length + length_to_goal, length_to_goal, next_idx, next_row * col + next_col));
+			}
+			else if (next_length < length_from_start[next_idx]) {
+				length_from_start[next_idx] = next_length;
+				parent_dir[next_idx] = static_cast<uint8_t>(d);
+				search_queue.decreaseKey(next_idx, next_length + search_queue.at(next_idx).length_to_goal);
+			}
+		}
+	}
+
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	res.search_ms = chrono::duration<double, milli>(end - begin).count();
+
+	// make result road to start point from goal
+	if (goal_idx != -1) {
+		Point track_road = goal_p;
+		while (true) {
+			int d = parent_dir[layout.index(track_road.row, track_road.col)];
+			track_road.row -= DIR_ROW[d];
+			track_road.col -= DIR_COL[d];
+			if (track_road == start)
+				break;
+
+			road.push_back(track_road.row * col + track_road.col);
+			res.length++;
+		}
+	}
+	// no result
+	else
+		res.length = -1;
+
+	return res;
+}
+
+// calc shortest length to several goals
+int shortestLength(int row, int col, vector<Point> &goal) {
+	int length = INT_MAX;
+
+	Point cur_p(row, col);
+	for (uint i = 0; i < goal.size(); i++) {
+		int curLength = DISTANCE(cur_p, goal[i]);
+
+		if (length > curLength)
+			length = curLength;
+	}
+
+	return length;
+}
@@ -0,0 +1,467 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <climits>
+#include <algorithm>
+#include <queue>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <chrono>
+
+// max row or col size of map -> build with -DMAX_MAP_SIZE=10000 for big maps
+#ifndef MAX_MAP_SIZE
+#define MAX_MAP_SIZE 500
+#endif
+
+// calc manhattan distance
+#define DISTANCE(p1, p2)	(abs(p1.row - p2.row) + \
+							 abs(p1.col - p2.col))
+
+using namespace std;
+
+// point info -> (row, col)
+typedef struct Point {
+	Point();
+	Point(int, int);
+	bool operator==(const Point &);
+	bool operator!=(const Point &);
+
+	int row;
+	int col;
+} Point;
+
+// open list node -> length from start + length to goal, length to goal, cell index
+typedef struct OpenNode {
+	OpenNode(int, int, int);
+	bool operator>(const OpenNode &) const;
+
+	int score;
+	int length_to_goal;
+	int cell;
+} OpenNode;
+
+// result info -> length, time
+typedef struct Result {
+	Result();
+	Result(int, int);
+	Result operator=(const Result &);
+
+	int length;
+	int time;
+} Result;
+
+// Map enum data
+typedef enum class Map {
+	WALL = 1,
+	ROAD = 2,
+	START = 3,
+	GOAL = 4,
+	ROAD_G = 5
+} Map;
+
+// per-cell search state -> length from start, parent cell index, closed flag
+typedef struct CellState {
+	CellState();
+
+	int length;
+	int parent;
+	bool closed;
+} CellState;
+
+// resumable A* search -> open and closed state is kept between step() calls
+// cell states live in a hash map, memory grows with touched cells and not with map size
+typedef struct Search {
+	Search(Map **, int, int, const Point &, vector<Point> *);
+	int step(int);
+	bool done() const;
+	const Result &result() const;
+
+	Map **map;
+	int row;
+	int col;
+	int start_idx;
+	vector<Point> *goal;
+
+	priority_queue<OpenNode, vector<OpenNode>, greater<OpenNode> > search_queue;
+	unordered_map<int, CellState> state;
+	vector<int> road;
+	Result res;
+	bool finished;
+} Search;
+
+// round-robin scheduler -> every search gets slice expansions in turn until frame budget is spent
+typedef struct Scheduler {
+	Scheduler(int);
+	void add(Search *);
+	bool empty() const;
+	double runFrame(double);
+
+	deque<Search *> active;
+	int slice;
+} Scheduler;
+
+Point::Point()
+	: row(-1), col(-1) {}
+
+Point::Point(int row_, int col_)
+	: row(row_), col(col_) {}
+
+bool Point::operator==(const Point &p) {
+	return (this->row == p.row && this->col == p.col);
+}
+
+bool Point::operator!=(const Point &p) {
+	return (this->row != p.row || this->col != p.col);
+}
+
+OpenNode::OpenNode(int score_, int length_to_goal_, int cell_)
+	: score(score_), length_to_goal(length_to_goal_), cell(cell_) {}
+
+// compare score -> smaller length, bigger score, closer to goal first on same score
+bool OpenNode::operator>(const OpenNode &n) const {
+	if (score != n.score)
+		return score > n.score;
+	if (length_to_goal != n.length_to_goal)
+		return length_to_goal > n.length_to_goal;
+
+	return cell > n.cell;
+}
+
+Result::Result()
+	: length(0), time(0) {}
+
+Result::Result(int length_, int time_)
+	: length(length_), time(time_) {}
+
+Result Result::operator= (const Result &res) {
+	length = res.length;
+	time = res.time;
+
+	return *this;
+}
+
+CellState::CellState()
+	: length(INT_MAX), parent(-1), closed(false) {}
+
+int MAP_SIZE_ROW = 0;
+int MAP_SIZE_COL = 0;
+
+int shortestLength(int, int, vector<Point> &);
+
+Search::Search(Map **map_, int row_, int col_, const Point &start, vector<Point> *goal_)
+	: map(map_), row(row_), col(col_), start_idx(start.row * col_ + start.col), goal(goal_), finished(false) {
+	CellState &s = state[start_idx];
+	s.length = 0;
+	s.parent = start_idx;
+
+	search_queue.push(OpenNode(0, 0, start_idx));
+}
+
+// expand at most max_expansions cells, return number of expanded cells
+int Search::step(int max_expansions) {
+	const int DIR_ROW[4] = {-1, 0, 1, 0};
+	const int DIR_COL[4] = {0, 1, 0, -1};
+
+	int expanded = 0;
+	while (!finished && expanded < max_expansions) {
+		// search_queue is empty when there is no result
+		if (search_queue.empty()) {
+			res.length = -1;
+			finished = true;
+			break;
+		}
+
+		OpenNode node = search_queue.top();
+		search_queue.pop();
+
+		// skip stale node -> cell was closed or got shorter length after the push
+		CellState &cur = state[node.cell];
+		if (cur.closed || node.score != cur.length + node.length_to_goal)
+			continue;
+
+		cur.closed = true;
+		expanded++;
+		res.time++;
+
+		int cur_row = node.cell / col;
+		int cur_col = node.cell % col;
+
+		// check if goal node -> make result road to start point from goal
+		if (map[cur_row][cur_col] == Map::GOAL) {
+			res.length = cur.length - 1;
+
+			int track_road = cur.parent;
+			while (track_road != start_idx) {
+				road.push_back(track_road);
+				track_road = state[track_road].parent;
+			}
+
+			finished = true;
+			break;
+		}
+
+		int next_length = cur.length + 1;
+		for (int d = 0; d < 4; d++) {
+			int next_row = cur_row + DIR_ROW[d];
+			int next_col = cur_col + DIR_COL[d];
+			if (next_row < 0 || next_row >= row || next_col < 0 || next_col >= col)
+				continue;
+
+			Map next_cell = map[next_row][next_col];
+			if (next_cell != Map::ROAD && next_cell != Map::GOAL)
+				continue;
+
+			int n = next_row * col + next_col;
+			CellState &next = state[n];
+			if (next.closed || next_length >= next.length)
+				continue;
+
+			next.length = next_length;
+			next.parent = node.cell;
+
+			int length_to_goal = shortestLength(next_row, next_col, *goal);
+			search_queue.push(OpenNode(next_length + length_to_goal, length_to_goal, n));
+		}
+	}
+
+	return expanded;
+}
+
+bool Search::done() const {
+	return finished;
+}
+
+const Result &Search::result() const {
+	return res;
+}
+
+Scheduler::Scheduler(int slice_)
+	: slice(slice_) {}
+
+void Scheduler::add(Search *search) {
+	active.push_back(search);
+}
+
+bool Scheduler::empty() const {
+	return active.empty();
+}
+
+// run searches in turn until frame budget is spent or every search is done
+// frame can exceed the budget by one slice (and a hash map rehash in it), return elapsed ms of the frame
+double Scheduler::runFrame(double budget_ms) {
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	double elapsed_ms = 0.0;
+
+	while (!active.empty() && elapsed_ms < budget_ms) {
+		Search *search = active.front();
+		active.pop_front();
+
+		search->step(slice);
+		if (!search->done())
+			active.push_back(search);
+
+		elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+	}
+
+	return elapsed_ms;
+}
+
+// usage: ./TSS [frame_ms] [slice] -> every 3 cell is an agent searching the nearest 4 cell
+// searches are advanced slice expansions (64 by default) at a time within frame_ms per frame (2.0 by default)
+int main (int argc, char *argv[]) {
+	string input_filename = "input.txt";
+	string output_filename = "output.txt";
+
+	// frame budget and expansions per turn
+	double frame_ms = 2.0;
+	int slice = 64;
+	if (argc > 1)
+		frame_ms = atof(argv[1]);
+	if (argc > 2)
+		slice = atoi(argv[2]);
+	if (frame_ms <= 0.0 || slice <= 0) {
+		cerr << "frame or slice value error" << endl;
+		return -1;
+	}
+
+	// open input.txt
+	ifstream input_f(input_filename);
+	if (!input_f.is_open()) {
+		cerr << "input file is not exist" << endl;
+
+		return -1;
+	}
+
+	// open output.txt
+	ofstream output_f(output_filename);
+	if (!output_f.is_open()) {
+		cerr << "output file cannot be opened" << endl;
+		input_f.close();
+
+		return -1;
+	}
+
+	// read
+	int row = 0;
+	int col = 0;
+	input_f >> row >> col;
+	if (row <= 0 || row > MAX_MAP_SIZE || col <= 0 || col > MAX_MAP_SIZE) {
+		cerr << "row or col value error" << endl;
+		return -1;
+	}
+
+	// set map size
+	MAP_SIZE_ROW = row;
+	MAP_SIZE_COL = col;
+
+	// allocate map array data
+	Map **map_info = NULL;
+	map_info = new Map *[row];
+	for (int i = 0; i < row; i++)
+		map_info[i] = new Map[col];
+
+	int map_1cell_data = 0;
+	int row_i = 0;
+	int col_j = 0;
+
+	// get map data from input.txt and fill map array data
+	vector<Point> start;
+	vector<Point> goal;
+	vector<Search *> search;
+	vector<int> done_frame;
+	Scheduler scheduler(slice);
+	int frame = 0;
+	double max_frame_ms = 0.0;
+	long long time = 0;
+	for (int i = 0; i < row * col; i++) {
+		if (input_f.eof()) {
+			cerr << "input file do not have sufficient map data" << endl;
+			goto RELEASE_DATA;
+		}
+
+		input_f >> map_1cell_data;
+		switch (map_1cell_data) {
+			case 1:
+				map_info[row_i][col_j] = Map::WALL;
+				break;
+
+			case 2:
+				map_info[row_i][col_j] = Map::ROAD;
+				break;
+
+			// start point can exist one or more
+			case 3:
+				map_info[row_i][col_j] = Map::START;
+				start.emplace_back(row_i, col_j);
+				break;
+
+			// goal point can exist one or more
+			case 4:
+				map_info[row_i][col_j] = Map::GOAL;
+				goal.emplace_back(row_i, col_j);
+				break;
+
+			default:
+				cerr << "input file have unknown map data" << endl;
+				goto RELEASE_DATA;
+		}
+
+		col_j++;
+		if (col_j >= col) {
+			row_i++;
+			col_j = 0;
+		}
+	}
+
+	// start num >= 1
+	// goal num >= 1
+	if (start.size() == 0 || goal.size() == 0) {
+		cerr << "input file start or goal data error" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// map data must have row * col data
+	if (!(row_i == row && col_j == 0)) {
+		cerr << "input file do not have sufficient map data" << endl;
+		goto RELEASE_DATA;
+	}
+
+	// one search per agent
+	for (uint i = 0; i < start.size(); i++) {
+		search.push_back(new Search(map_info, row, col, start[i], &goal));
+		scheduler.add(search[i]);
+	}
+
+	// run frames until every search is done, keep frame of completion of every agent
+	done_frame.assign(start.size(), -1);
+	while (!scheduler.empty()) {
+		max_frame_ms = max(max_frame_ms, scheduler.runFrame(frame_ms));
+		frame++;
+
+		for (uint i = 0; i < search.size(); i++)
+			if (done_frame[i] == -1 && search[i]->done())
+				done_frame[i] = frame;
+	}
+
+	// every result road
+	for (uint i = 0; i < search.size(); i++) {
+		for (uint j = 0; j < search[i]->road.size(); j++)
+			map_info[search[i]->road[j] / col][search[i]->road[j] % col] = Map::ROAD_G;
+		time += search[i]->result().time;
+	}
+
+	// write
+	for (int i = 0; i < row; i++) {
+		for (int j = 0; j < col; j++) {
+			output_f << static_cast<int>(map_info[i][j]) << " ";
+		}
+
+		output_f << endl;
+	}
+
+	output_f << "---" << endl;
+	// agent table -> (row,col) length time frame, -1 length -> no result
+	for (uint i = 0; i < search.size(); i++) {
+		output_f << "(" << start[i].row << "," << start[i].col << ") ";
+		output_f << "length=" << search[i]->result().length << " ";
+		output_f << "time=" << search[i]->result().time << " ";
+		output_f << "frame=" << done_frame[i] << endl;
+	}
+
+	output_f << "time=" << time << endl;
+	output_f << "agents=" << search.size() << endl;
+	output_f << "frames=" << frame << endl;
+	output_f << "max_frame_ms=" << max_frame_ms << endl;
+
+	for (uint i = 0; i < search.size(); i++)
+		delete search[i];
+
+RELEASE_DATA:
+	input_f.close();
+	output_f.close();
+
+	for (int i = 0; i < row_i; i++)
+		delete[] map_info[i];
+	delete[] map_info;
+
+	return 0;
+}
+
+// calc shortest length to several goals
+int shortestLength(int row, int col, vector<Point> &goal) {
+	int length = INT_MAX;
+
+	Point cur_p(row, col);
+	for (uint i = 0; i < goal.size(); i++) {
+		int curLength = DISTANCE(cur_p, goal[i]);
+
+		if (length > curLength)
+			length = curLength;
+	}
+
+	return length;
+}